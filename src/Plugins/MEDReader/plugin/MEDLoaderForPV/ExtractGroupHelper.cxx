@@ -27,8 +27,11 @@
 #include "vtkMutableDirectedGraph.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkStringArray.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
 
 #include <cstring>
+#include <algorithm>
 
 const char ExtractGroupGrp::START[]="GRP_";
 
@@ -306,27 +309,19 @@ std::set<int> ExtractGroupInternal::getIdsToKeep() const
   return s;
 }
 
-// see reference : https://en.cppreference.com/w/cpp/iterator/iterator
-class FamilyIterator : public std::iterator< std::input_iterator_tag, long, long, int*, int >
-{
-  long _num = 0;
-  const ExtractGroupInternal *_egi = nullptr;
-  const std::vector<std::string> *_fams = nullptr;
-public:
-  explicit FamilyIterator(long num , const ExtractGroupInternal *egi, const std::vector<std::string>& fams) : _num(num),_egi(egi),_fams(&fams) {}
-  FamilyIterator& operator++() { ++_num; return *this;}
-  bool operator==(const FamilyIterator& other) const {return _num == other._num;}
-  bool operator!=(const FamilyIterator& other) const {return !(*this == other);}
-  reference operator*() const {return _egi->getIdOfFamily((*_fams)[_num]);}
-};
-
 std::vector< std::pair<std::string,std::vector<int> > > ExtractGroupInternal::getAllGroups() const
 {
     std::vector< std::pair<std::string,std::vector<int> > > ret;
+    std::map<std::string,int> famStrId(computeFamStrIdMap());
     for(const auto&  grp : _groups)
     {
         const std::vector<std::string>& fams(grp.getFamiliesLyingOn());
-        std::vector<int> famIds(FamilyIterator(0,this,fams),FamilyIterator(fams.size(),this,fams));
+        std::vector<int> famIds;
+        for(const auto& fam : fams)
+        {
+            auto it(famStrId.find(fam));
+            famIds.push_back(it!=famStrId.end()?(*it).second:std::numeric_limits<int>::max());
+        }
         std::pair<std::string,std::vector<int> > elt(grp.getName(),std::move(famIds));
         ret.emplace_back(std::move(elt));
     }
@@ -349,3 +344,75 @@ std::map<std::string,int> ExtractGroupInternal::computeFamStrIdMap() const
     ret[(*it0).getName()]=(*it0).getId();
   return ret;
 }
+
+const MEDCoupling::mcIdType ExtractGroupFamilySelector::MAX_DENSE_RANGE=1<<20;
+
+ExtractGroupFamilySelector::ExtractGroupFamilySelector(const std::set<int>& idsToKeep):_nb_of_ids(idsToKeep.size()),_is_dense(false),_min(0)
+{
+  if(idsToKeep.empty())
+    return ;
+  _min=*idsToKeep.begin();
+  long long range((long long)*idsToKeep.rbegin()-(long long)*idsToKeep.begin()+1);// no overflow with 32 bits ids
+  _is_dense=range<=(long long)MAX_DENSE_RANGE;
+  int pos(0);
+  if(_is_dense)
+    {
+      _dense.resize(range,0);
+      for(std::set<int>::const_iterator it=idsToKeep.begin();it!=idsToKeep.end();it++)
+        _dense[*it-_min]=++pos;
+    }
+  else
+    for(std::set<int>::const_iterator it=idsToKeep.begin();it!=idsToKeep.end();it++)
+      _sparse[*it]=pos++;
+}
+
+class ExtractGroupFamilySelectorFunctor
+{
+public:
+  ExtractGroupFamilySelectorFunctor(const ExtractGroupFamilySelector& selector, std::size_t nbOfIds, const MEDCoupling::mcIdType *famIds, char *mask, char selectedValue):
+    _selector(selector),_nb_of_ids(nbOfIds),_fam_ids(famIds),_mask(mask),_selected_value(selectedValue) { }
+  void Initialize() { _found.Local().assign(_nb_of_ids,0); }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<char>& found(_found.Local());
+    for(vtkIdType i=begin;i<end;i++)
+      {
+        int pos(_selector.indexOf(_fam_ids[i]));
+        if(pos>=0)
+          { _mask[i]=_selected_value; found[pos]=1; }
+        else
+          _mask[i]=0;
+      }
+  }
+  void Reduce() { }
+  //! families found in at least one tuple
+  std::vector<char> getFound()
+  {
+    std::vector<char> ret(_nb_of_ids,0);
+    for(vtkSMPThreadLocal< std::vector<char> >::iterator it=_found.begin();it!=_found.end();++it)
+      for(std::size_t i=0;i<_nb_of_ids;i++)
+        ret[i]=ret[i]|(*it)[i];
+    return ret;
+  }
+private:
+  const ExtractGroupFamilySelector& _selector;
+  std::size_t _nb_of_ids;
+  const MEDCoupling::mcIdType *_fam_ids;
+  char *_mask;
+  char _selected_value;
+  vtkSMPThreadLocal< std::vector<char> > _found;
+};
+
+/*!
+ * \param [out] mask - of size \a nbOfTuples. Set to \a selectedValue for the tuples kept, 0 for the others.
+ * \param [out] catchAll - true if all the ids to keep are found in \a famIds.
+ * \param [out] catchSmth - true if at least one id to keep is found in \a famIds.
+ */
+void ExtractGroupFamilySelector::select(const MEDCoupling::mcIdType *famIds, MEDCoupling::mcIdType nbOfTuples, char *mask, char selectedValue, bool& catchAll, bool& catchSmth) const
+{
+  ExtractGroupFamilySelectorFunctor functor(*this,_nb_of_ids,famIds,mask,selectedValue);
+  vtkSMPTools::For(0,nbOfTuples,functor);
+  std::vector<char> found(functor.getFound());
+  catchAll=std::find(found.begin(),found.end(),0)==found.end();
+  catchSmth=std::find(found.begin(),found.end(),1)!=found.end();
+}
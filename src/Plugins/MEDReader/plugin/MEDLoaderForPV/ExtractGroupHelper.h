@@ -24,8 +24,10 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 
 #include "MEDLoaderForPV.h"
+#include "MCType.hxx"
 
 class MEDLOADERFORPV_EXPORT ExtractGroupStatus
 {
@@ -102,3 +104,33 @@ private:
   std::string _mesh_name;
 };
 
+
+/*!
+ * Selects in a single pass the tuples of a family id array whose family is one of the ids to keep. Families are looked up in a dense
+ * table covering [min,max] of the ids to keep when this range is small enough, in a hash table otherwise.
+ */
+class MEDLOADERFORPV_EXPORT ExtractGroupFamilySelector
+{
+public:
+  ExtractGroupFamilySelector(const std::set<int>& idsToKeep);
+  void select(const MEDCoupling::mcIdType *famIds, MEDCoupling::mcIdType nbOfTuples, char *mask, char selectedValue, bool& catchAll, bool& catchSmth) const;
+  bool isDense() const { return _is_dense; }
+  //! position of \a famId in the ids to keep, -1 if not kept.
+  int indexOf(MEDCoupling::mcIdType famId) const
+  {
+    if(_is_dense)
+      return famId>=_min && famId-_min<(MEDCoupling::mcIdType)_dense.size()?_dense[famId-_min]-1:-1;
+    std::unordered_map<MEDCoupling::mcIdType,int>::const_iterator it(_sparse.find(famId));
+    return it!=_sparse.end()?(*it).second:-1;
+  }
+public:
+  //! largest range of the ids to keep dealt with a dense table.
+  static const MEDCoupling::mcIdType MAX_DENSE_RANGE;
+private:
+  std::size_t _nb_of_ids;
+  bool _is_dense;
+  MEDCoupling::mcIdType _min;
+  //! position+1 of each id of [_min,_min+_dense.size()) in the ids to keep, 0 if not kept.
+  std::vector<int> _dense;
+  std::unordered_map<MEDCoupling::mcIdType,int> _sparse;
+};
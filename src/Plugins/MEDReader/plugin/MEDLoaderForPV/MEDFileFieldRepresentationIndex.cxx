@@ -0,0 +1,545 @@
+// Copyright (C) 2010-2021  CEA/DEN, EDF R&D
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#include "MEDFileFieldRepresentationIndex.hxx"
+#include "MEDFileFieldRepresentationTree.hxx"
+
+#include "InterpKernelException.hxx"
+
+#include "vtkMutableDirectedGraph.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <exception>
+
+const char MEDFileFieldRepresentationIndex::HEADER[]="MEDREADER_INDEX";
+
+const int MEDFileFieldRepresentationIndex::VERSION=2;// 2 : modification time in nanoseconds
+
+const char MEDFileFieldRepresentationIndex::EXTENSION[]=".pvidx";
+
+MEDFileFieldRepresentationIndex::MEDFileFieldRepresentationIndex():_loaded(false)
+{
+}
+
+void MEDFileFieldRepresentationIndex::clear()
+{
+  _time_series.clear();
+  _meshes.clear();
+  _full_names.clear();
+  _id_per_name.clear();
+  _status.clear();
+  _loaded=false;
+}
+
+/*!
+ * Numbers the arrays and computes their full names the same way than MEDFileFieldRepresentationTree::assignIds and MEDFileFieldRepresentationTree::computeFullNameInLeaves.
+ * After this call the index can answer to the requests.
+ */
+void MEDFileFieldRepresentationIndex::finalize()
+{
+  _full_names.clear();
+  std::size_t it0Cnt(0);
+  for(std::vector< TimeSeries >::iterator it0=_time_series.begin();it0!=_time_series.end();it0++,it0Cnt++)
+    {
+      if((*it0)._leaves.size()!=(*it0)._mesh_names.size())
+        throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationIndex::finalize : mismatch between meshes and leaves !");
+      std::ostringstream oss; oss << MEDFileFieldRepresentationLeavesArrays::TS_STR << it0Cnt;
+      std::string tsName(oss.str());
+      std::size_t it1Cnt(0);
+      for(std::vector< std::vector< Leaf > >::iterator it1=(*it0)._leaves.begin();it1!=(*it0)._leaves.end();it1++,it1Cnt++)
+        {
+          std::size_t it2Cnt(0);
+          for(std::vector< Leaf >::iterator it2=(*it1).begin();it2!=(*it1).end();it2++,it2Cnt++)
+            {
+              std::ostringstream oss2; oss2 << tsName << "/" << (*it0)._mesh_names[it1Cnt] << "/" << MEDFileFieldRepresentationLeavesArrays::COM_SUP_STR << it2Cnt << "/";
+              (*it2)._first_id=(int)_full_names.size();
+              for(std::vector<std::string>::const_iterator it3=(*it2)._arr_names.begin();it3!=(*it2)._arr_names.end();it3++)
+                _full_names.push_back(oss2.str()+(*it3));
+            }
+        }
+    }
+  _id_per_name.clear();
+  for(std::size_t i=0;i<_full_names.size();i++)
+    _id_per_name[_full_names[i]]=(int)i;
+  _status.clear(); _status.resize(_full_names.size(),false);
+  _loaded=true;
+}
+
+/*!
+ * \param [in] indexFileName - the index file to be read.
+ * \param [in] medFileName - the MED file the index has to correspond to.
+ * \return true if the index has been read and is valid for \a medFileName. If false \a this is left empty.
+ */
+bool MEDFileFieldRepresentationIndex::load(const std::string& indexFileName, const std::string& medFileName)
+{
+  clear();
+  long long size(0),mtime(0),indexSize(0),indexMtime(0);
+  if(!GetFileStamp(medFileName,size,mtime) || !GetFileStamp(indexFileName,indexSize,indexMtime))
+    return false;
+  std::ifstream ifs(indexFileName.c_str(),std::ios::binary);
+  if(!ifs)
+    return false;
+  // each element counted in the index takes at least one byte of it : counts and sizes read are bounded by the size of the index
+  std::size_t maxCount((std::size_t)indexSize);
+  try
+    {
+      std::string header;
+      int version(0);
+      long long size2(0),mtime2(0);
+      ifs >> header >> version >> size2 >> mtime2;
+      if(!ifs || header!=HEADER || version!=VERSION || size!=size2 || mtime!=mtime2)
+        return false;
+      std::size_t nbTS(ReadCount(ifs,maxCount));
+      _time_series.resize(nbTS);
+      for(std::vector< TimeSeries >::iterator it0=_time_series.begin();it0!=_time_series.end() && ifs;it0++)
+        {
+          (*it0)._overview=ReadString(ifs,maxCount);
+          std::size_t nbSteps(ReadCount(ifs,maxCount));
+          (*it0)._dtits.resize(nbSteps); (*it0)._ts.resize(nbSteps);
+          for(std::size_t i=0;i<nbSteps && ifs;i++)
+            ifs >> (*it0)._dtits[i].first >> (*it0)._dtits[i].second >> (*it0)._ts[i];
+          std::size_t nbMeshes(ReadCount(ifs,maxCount));
+          (*it0)._mesh_names.resize(nbMeshes); (*it0)._leaves.resize(nbMeshes);
+          for(std::size_t i=0;i<nbMeshes && ifs;i++)
+            {
+              (*it0)._mesh_names[i]=ReadString(ifs,maxCount);
+              std::size_t nbLeaves(ReadCount(ifs,maxCount));
+              (*it0)._leaves[i].resize(nbLeaves);
+              for(std::vector< Leaf >::iterator it2=(*it0)._leaves[i].begin();it2!=(*it0)._leaves[i].end() && ifs;it2++)
+                {
+                  std::size_t nbArrs(ReadCount(ifs,maxCount));
+                  for(std::size_t j=0;j<nbArrs && ifs;j++)
+                    {
+                      int isFieldMesh(0);
+                      ifs >> isFieldMesh;
+                      (*it2)._arr_is_field_mesh.push_back(isFieldMesh!=0);
+                      (*it2)._arr_names.push_back(ReadString(ifs,maxCount));
+                    }
+                  std::size_t nbGTs(ReadCount(ifs,maxCount));
+                  for(std::size_t j=0;j<nbGTs && ifs;j++)
+                    (*it2)._geo_types.push_back(ReadString(ifs,maxCount));
+                }
+            }
+        }
+      std::size_t nbMeshes(ReadCount(ifs,maxCount));
+      _meshes.resize(nbMeshes);
+      for(std::vector< MeshInfo >::iterator it=_meshes.begin();it!=_meshes.end() && ifs;it++)
+        {
+          (*it)._name=ReadString(ifs,maxCount);
+          std::size_t nbGrps(ReadCount(ifs,maxCount));
+          (*it)._fams_on_grps.resize(nbGrps);
+          for(std::size_t i=0;i<nbGrps && ifs;i++)
+            {
+              (*it)._grps.push_back(ReadString(ifs,maxCount));
+              std::size_t nbFams(ReadCount(ifs,maxCount));
+              for(std::size_t j=0;j<nbFams && ifs;j++)
+                (*it)._fams_on_grps[i].push_back(ReadString(ifs,maxCount));
+            }
+          std::size_t nbFams(ReadCount(ifs,maxCount));
+          for(std::size_t i=0;i<nbFams && ifs;i++)
+            {
+              int famId(0);
+              ifs >> famId;
+              (*it)._fam_ids.push_back(famId);
+              (*it)._fams.push_back(ReadString(ifs,maxCount));
+            }
+        }
+      std::string footer;
+      ifs >> footer;
+      if(!ifs || footer!=HEADER || _time_series.empty())
+        {
+          clear();
+          return false;
+        }
+      finalize();
+    }
+  catch(std::exception&)
+    {// corrupted index (INTERP_KERNEL::Exception) or allocation failure. It is simply ignored.
+      clear();
+      return false;
+    }
+  return true;
+}
+
+/*!
+ * Writes \a this into \a indexFileName. Failure to write is silently ignored : the index is only an accelerator.
+ * The file is first written aside and then renamed to avoid that a concurrent reader sees a partial index.
+ */
+void MEDFileFieldRepresentationIndex::save(const std::string& indexFileName, const std::string& medFileName) const
+{
+  long long size(0),mtime(0);
+  if(!GetFileStamp(medFileName,size,mtime))
+    return ;
+  std::string tmpFileName(indexFileName+".tmp");
+  {
+    std::ofstream ofs(tmpFileName.c_str(),std::ios::binary);
+    if(!ofs)
+      return ;
+    ofs.precision(17);
+    ofs << HEADER << " " << VERSION << " " << size << " " << mtime << "\n";
+    ofs << _time_series.size() << "\n";
+    for(std::vector< TimeSeries >::const_iterator it0=_time_series.begin();it0!=_time_series.end();it0++)
+      {
+        WriteString(ofs,(*it0)._overview);
+        ofs << (*it0)._dtits.size() << "\n";
+        for(std::size_t i=0;i<(*it0)._dtits.size();i++)
+          ofs << (*it0)._dtits[i].first << " " << (*it0)._dtits[i].second << " " << (*it0)._ts[i] << "\n";
+        ofs << (*it0)._mesh_names.size() << "\n";
+        for(std::size_t i=0;i<(*it0)._mesh_names.size();i++)
+          {
+            WriteString(ofs,(*it0)._mesh_names[i]);
+            ofs << (*it0)._leaves[i].size() << "\n";
+            for(std::vector< Leaf >::const_iterator it2=(*it0)._leaves[i].begin();it2!=(*it0)._leaves[i].end();it2++)
+              {
+                ofs << (*it2)._arr_names.size() << "\n";
+                for(std::size_t j=0;j<(*it2)._arr_names.size();j++)
+                  {
+                    ofs << ((*it2)._arr_is_field_mesh[j]?1:0) << " ";
+                    WriteString(ofs,(*it2)._arr_names[j]);
+                  }
+                ofs << (*it2)._geo_types.size() << "\n";
+                for(std::vector<std::string>::const_iterator it3=(*it2)._geo_types.begin();it3!=(*it2)._geo_types.end();it3++)
+                  WriteString(ofs,*it3);
+              }
+          }
+      }
+    ofs << _meshes.size() << "\n";
+    for(std::vector< MeshInfo >::const_iterator it=_meshes.begin();it!=_meshes.end();it++)
+      {
+        WriteString(ofs,(*it)._name);
+        ofs << (*it)._grps.size() << "\n";
+        for(std::size_t i=0;i<(*it)._grps.size();i++)
+          {
+            WriteString(ofs,(*it)._grps[i]);
+            ofs << (*it)._fams_on_grps[i].size() << "\n";
+            for(std::vector<std::string>::const_iterator it2=(*it)._fams_on_grps[i].begin();it2!=(*it)._fams_on_grps[i].end();it2++)
+              WriteString(ofs,*it2);
+          }
+        ofs << (*it)._fams.size() << "\n";
+        for(std::size_t i=0;i<(*it)._fams.size();i++)
+          {
+            ofs << (*it)._fam_ids[i] << " ";
+            WriteString(ofs,(*it)._fams[i]);
+          }
+      }
+    ofs << HEADER << "\n";
+    if(!ofs)
+      {
+        ofs.close();
+        std::remove(tmpFileName.c_str());
+        return ;
+      }
+  }
+  std::remove(indexFileName.c_str());
+  if(std::rename(tmpFileName.c_str(),indexFileName.c_str())!=0)
+    std::remove(tmpFileName.c_str());
+}
+
+void MEDFileFieldRepresentationIndex::activateTheFirst() const
+{
+  for(std::vector< TimeSeries >::const_iterator it0=_time_series.begin();it0!=_time_series.end();it0++)
+    for(std::vector< std::vector< Leaf > >::const_iterator it1=(*it0)._leaves.begin();it1!=(*it0)._leaves.end();it1++)
+      for(std::vector< Leaf >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+        {
+          for(std::size_t i=0;i<(*it2)._arr_names.size();i++)
+            _status[(*it2)._first_id+i]=true;
+          return ;
+        }
+}
+
+/*!
+ * Same graph than the one built by MEDFileFieldRepresentationTree::feedSIL.
+ */
+void MEDFileFieldRepresentationIndex::feedSIL(vtkMutableDirectedGraph* sil, vtkIdType root, vtkVariantArray *edge, std::vector<std::string>& names) const
+{
+  std::size_t it0Cnt(0);
+  for(std::vector< TimeSeries >::const_iterator it0=_time_series.begin();it0!=_time_series.end();it0++,it0Cnt++)
+    {
+      vtkIdType InfoOnTSId(sil->AddChild(root,edge));
+      names.push_back((*it0)._overview);
+      //
+      vtkIdType NbOfTSId(sil->AddChild(InfoOnTSId,edge));
+      std::size_t nbOfTS((*it0)._dtits.size());
+      std::ostringstream oss3; oss3 << nbOfTS;
+      names.push_back(oss3.str());
+      for(std::size_t i=0;i<nbOfTS;i++)
+        {
+          std::ostringstream oss4; oss4 << (*it0)._dtits[i].first;
+          vtkIdType DtId(sil->AddChild(NbOfTSId,edge));
+          names.push_back(oss4.str());
+          std::ostringstream oss5; oss5 << (*it0)._dtits[i].second;
+          vtkIdType ItId(sil->AddChild(DtId,edge));
+          names.push_back(oss5.str());
+          std::ostringstream oss6; oss6 << (*it0)._ts[i];
+          sil->AddChild(ItId,edge);
+          names.push_back(oss6.str());
+        }
+      //
+      std::ostringstream oss; oss << MEDFileFieldRepresentationLeavesArrays::TS_STR << it0Cnt;
+      vtkIdType typeId0(sil->AddChild(root,edge));
+      names.push_back(oss.str());
+      std::size_t it1Cnt(0);
+      for(std::vector< std::vector< Leaf > >::const_iterator it1=(*it0)._leaves.begin();it1!=(*it0)._leaves.end();it1++,it1Cnt++)
+        {
+          vtkIdType typeId1(sil->AddChild(typeId0,edge));
+          names.push_back((*it0)._mesh_names[it1Cnt]);
+          std::size_t it2Cnt(0);
+          for(std::vector< Leaf >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++,it2Cnt++)
+            {
+              std::ostringstream oss2; oss2 << MEDFileFieldRepresentationLeavesArrays::COM_SUP_STR << it2Cnt;
+              vtkIdType typeId2(sil->AddChild(typeId1,edge));
+              names.push_back(oss2.str());
+              //
+              vtkIdType root2(sil->AddChild(typeId2,edge));
+              names.push_back(std::string("Arrs"));
+              for(std::size_t i=0;i<(*it2)._arr_names.size();i++)
+                {
+                  vtkIdType refId(sil->AddChild(root2,edge));
+                  names.push_back((*it2)._arr_names[i]);
+                  if((*it2)._arr_is_field_mesh[i])
+                    {
+                      sil->AddChild(refId,edge);
+                      names.push_back(std::string());
+                    }
+                }
+              vtkIdType root3(sil->AddChild(typeId2,edge));
+              names.push_back(std::string("InfoOnGeoType"));
+              for(std::vector<std::string>::const_iterator it3=(*it2)._geo_types.begin();it3!=(*it2)._geo_types.end();it3++)
+                {
+                  sil->AddChild(root3,edge);
+                  names.push_back(*it3);
+                }
+            }
+        }
+    }
+}
+
+std::string MEDFileFieldRepresentationIndex::getActiveMeshName() const
+{
+  int lev0(0),lev1(0);
+  getTheSingleActivated(lev0,lev1);
+  return _time_series[lev0]._mesh_names[lev1];
+}
+
+/*!
+ * Same graph than the one built by MEDFileFieldRepresentationTree::feedSILForFamsAndGrps.
+ */
+std::string MEDFileFieldRepresentationIndex::feedSILForFamsAndGrps(vtkMutableDirectedGraph* sil, vtkIdType root, vtkVariantArray *edge, std::vector<std::string>& names) const
+{
+  std::string ret(getActiveMeshName());
+  std::vector< MeshInfo >::const_iterator m(_meshes.begin());
+  for(;m!=_meshes.end();m++)
+    if((*m)._name==ret)
+      break;
+  if(m==_meshes.end())
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationIndex::feedSILForFamsAndGrps : internal error #0 !");
+  vtkIdType typeId0(sil->AddChild(root,edge));
+  names.push_back((*m)._name);
+  //
+  vtkIdType typeId1(sil->AddChild(typeId0,edge));
+  names.push_back(std::string(MEDFileFieldRepresentationTree::ROOT_OF_GRPS_IN_TREE));
+  for(std::size_t i=0;i<(*m)._grps.size();i++)
+    {
+      vtkIdType typeId2(sil->AddChild(typeId1,edge));
+      names.push_back((*m)._grps[i]);
+      for(std::vector<std::string>::const_iterator it1=(*m)._fams_on_grps[i].begin();it1!=(*m)._fams_on_grps[i].end();it1++)
+        {
+          sil->AddChild(typeId2,edge);
+          names.push_back(*it1);
+        }
+    }
+  //
+  vtkIdType typeId11(sil->AddChild(typeId0,edge));
+  names.push_back(std::string(MEDFileFieldRepresentationTree::ROOT_OF_FAM_IDS_IN_TREE));
+  for(std::size_t i=0;i<(*m)._fams.size();i++)
+    {
+      sil->AddChild(typeId11,edge);
+      std::ostringstream oss; oss << (*m)._fams[i] << MEDFileFieldRepresentationLeavesArrays::ZE_SEP << (*m)._fam_ids[i];
+      names.push_back(oss.str());
+    }
+  return ret;
+}
+
+std::string MEDFileFieldRepresentationIndex::getNameOf(int id) const
+{
+  checkId(id);
+  return _full_names[id];
+}
+
+const char *MEDFileFieldRepresentationIndex::getNameOfC(int id) const
+{
+  checkId(id);
+  return _full_names[id].c_str();
+}
+
+bool MEDFileFieldRepresentationIndex::getStatusOf(int id) const
+{
+  checkId(id);
+  return _status[id];
+}
+
+int MEDFileFieldRepresentationIndex::getIdHavingZeName(const char *name) const
+{
+  std::unordered_map<std::string,int>::const_iterator it(_id_per_name.find(name));
+  if(it!=_id_per_name.end())
+    return (*it).second;
+  std::ostringstream msg; msg << "MEDFileFieldRepresentationIndex::getIdHavingZeName : No such a name \"" << name << "\" !";
+  throw INTERP_KERNEL::Exception(msg.str().c_str());
+}
+
+bool MEDFileFieldRepresentationIndex::changeStatusOf(int id, bool status) const
+{
+  checkId(id);
+  bool ret(_status[id]!=status);
+  _status[id]=status;
+  return ret;
+}
+
+int MEDFileFieldRepresentationIndex::getMaxNumberOfTimeSteps() const
+{
+  int ret(0);
+  for(std::vector< TimeSeries >::const_iterator it0=_time_series.begin();it0!=_time_series.end();it0++)
+    ret=std::max(ret,(int)(*it0)._dtits.size());
+  return ret;
+}
+
+std::string MEDFileFieldRepresentationIndex::getDftMeshName() const
+{
+  return _time_series[0]._mesh_names[0];
+}
+
+std::vector< std::pair<int,int> > MEDFileFieldRepresentationIndex::getTimeStepsOfActivated(int& lev0, std::vector<double>& ts) const
+{
+  int lev1(0);
+  getTheSingleActivated(lev0,lev1);
+  ts=_time_series[lev0]._ts;
+  return _time_series[lev0]._dtits;
+}
+
+/*!
+ * \param [in] indexDirectory - if empty the index is put next to \a medFileName. If not, the index is put in this directory with a name derived from \a medFileName.
+ */
+std::string MEDFileFieldRepresentationIndex::BuildIndexFileName(const std::string& medFileName, const std::string& indexDirectory)
+{
+  if(indexDirectory.empty())
+    return medFileName+EXTENSION;
+  std::string mangled(medFileName);
+  for(std::string::iterator it=mangled.begin();it!=mangled.end();it++)
+    if(*it=='/' || *it=='\\' || *it==':')
+      *it='_';
+  std::string ret(indexDirectory);
+  if(ret[ret.size()-1]!='/' && ret[ret.size()-1]!='\\')
+    ret+='/';
+  return ret+mangled+EXTENSION;
+}
+
+/*!
+ * \param [out] mtime - modification time of \a fileName in nanoseconds. Under Windows its resolution is only one second : a MED file rewritten
+ *              with the same size within the second its index has been built from is not detected.
+ */
+bool MEDFileFieldRepresentationIndex::GetFileStamp(const std::string& fileName, long long& size, long long& mtime)
+{
+#ifdef WIN32
+  struct _stat64 st;
+  if(_stat64(fileName.c_str(),&st)!=0)
+    return false;
+  mtime=(long long)st.st_mtime*1000000000LL;
+#else
+  struct stat st;
+  if(stat(fileName.c_str(),&st)!=0)
+    return false;
+#ifdef __APPLE__
+  mtime=(long long)st.st_mtimespec.tv_sec*1000000000LL+(long long)st.st_mtimespec.tv_nsec;
+#else
+  mtime=(long long)st.st_mtim.tv_sec*1000000000LL+(long long)st.st_mtim.tv_nsec;
+#endif
+#endif
+  size=(long long)st.st_size;
+  return true;
+}
+
+const MEDFileFieldRepresentationIndex::Leaf& MEDFileFieldRepresentationIndex::getTheSingleActivated(int& lev0, int& lev1) const
+{
+  const Leaf *ret(0);
+  int nbOfActivated(0),i0(0);
+  for(std::vector< TimeSeries >::const_iterator it0=_time_series.begin();it0!=_time_series.end();it0++,i0++)
+    {
+      int i1(0);
+      for(std::vector< std::vector< Leaf > >::const_iterator it1=(*it0)._leaves.begin();it1!=(*it0)._leaves.end();it1++,i1++)
+        for(std::vector< Leaf >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+          for(std::size_t i=0;i<(*it2)._arr_names.size();i++)
+            if(_status[(*it2)._first_id+i])
+              {
+                if(!ret)
+                  { ret=&(*it2); lev0=i0; lev1=i1; }
+                nbOfActivated++;
+                break;
+              }
+    }
+  if(nbOfActivated!=1)
+    {
+      std::ostringstream oss; oss << "MEDFileFieldRepresentationIndex::getTheSingleActivated : Only one leaf must be activated ! Having " << nbOfActivated << " !";
+      throw INTERP_KERNEL::Exception(oss.str().c_str());
+    }
+  return *ret;
+}
+
+void MEDFileFieldRepresentationIndex::checkId(int id) const
+{
+  if(id<0 || id>=(int)_full_names.size())
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationIndex::checkId : No such id !");
+}
+
+void MEDFileFieldRepresentationIndex::WriteString(std::ostream& os, const std::string& str)
+{
+  os << str.size() << ":" << str << "\n";
+}
+
+/*!
+ * \param [in] maxCount - upper bound of the count read. Above the index is considered as corrupted.
+ */
+std::size_t MEDFileFieldRepresentationIndex::ReadCount(std::istream& is, std::size_t maxCount)
+{
+  std::size_t ret(0);
+  is >> ret;
+  if(!is || ret>maxCount)
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationIndex::ReadCount : corrupted index !");
+  return ret;
+}
+
+std::string MEDFileFieldRepresentationIndex::ReadString(std::istream& is, std::size_t maxSize)
+{
+  std::size_t sz(0);
+  char sep(0);
+  is >> sz;
+  is.get(sep);
+  if(!is || sep!=':' || sz>maxSize)
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationIndex::ReadString : corrupted index !");
+  std::string ret(sz,'\0');
+  if(sz>0)
+    is.read(&ret[0],sz);
+  if(!is)
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationIndex::ReadString : corrupted index !");
+  return ret;
+}
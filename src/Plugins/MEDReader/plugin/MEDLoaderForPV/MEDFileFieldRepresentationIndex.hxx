@@ -0,0 +1,121 @@
+// Copyright (C) 2010-2021  CEA/DEN, EDF R&D
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#ifndef __MEDFILEFIELDREPRESENTATIONINDEX_HXX__
+#define __MEDFILEFIELDREPRESENTATIONINDEX_HXX__
+
+#include "MEDLoaderForPV.h"
+
+#include "vtkType.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iosfwd>
+
+class vtkMutableDirectedGraph;
+class vtkVariantArray;
+
+/*!
+ * On disk image of the information given by MEDFileFieldRepresentationTree to the pipeline before any RequestData :
+ * the tree of the arrays, the time steps, the geometric types of the supports and the groups/families of the meshes.
+ * An index is valid only for the MED file having the size and the modification time it has been built from.
+ * When an index is loaded in a MEDFileFieldRepresentationTree, the tree answers to the requests on the structure
+ * without having read the MED file.
+ */
+class MEDLOADERFORPV_EXPORT MEDFileFieldRepresentationIndex
+{
+public:
+  class Leaf
+  {
+  public:
+    Leaf():_first_id(0) { }
+  public:
+    //! short names of the arrays (without TS/mesh/ComSup prefix)
+    std::vector<std::string> _arr_names;
+    std::vector<bool> _arr_is_field_mesh;
+    std::vector<std::string> _geo_types;
+    int _first_id;
+  };
+  class TimeSeries
+  {
+  public:
+    std::string _overview;
+    std::vector< std::pair<int,int> > _dtits;
+    std::vector<double> _ts;
+    //! 1st : meshName, 2nd : common support
+    std::vector< std::vector< Leaf > > _leaves;
+    std::vector< std::string > _mesh_names;
+  };
+  class MeshInfo
+  {
+  public:
+    std::string _name;
+    std::vector<std::string> _grps;
+    std::vector< std::vector<std::string> > _fams_on_grps;
+    std::vector<std::string> _fams;
+    std::vector<int> _fam_ids;
+  };
+public:
+  MEDFileFieldRepresentationIndex();
+  bool isLoaded() const { return _loaded; }
+  void clear();
+  void finalize();
+  bool load(const std::string& indexFileName, const std::string& medFileName);
+  void save(const std::string& indexFileName, const std::string& medFileName) const;
+  //
+  int getNumberOfLeavesArrays() const { return (int)_full_names.size(); }
+  void activateTheFirst() const;
+  void feedSIL(vtkMutableDirectedGraph* sil, vtkIdType root, vtkVariantArray *edge, std::vector<std::string>& names) const;
+  std::string getActiveMeshName() const;
+  std::string feedSILForFamsAndGrps(vtkMutableDirectedGraph* sil, vtkIdType root, vtkVariantArray *edge, std::vector<std::string>& names) const;
+  std::string getNameOf(int id) const;
+  const char *getNameOfC(int id) const;
+  bool getStatusOf(int id) const;
+  int getIdHavingZeName(const char *name) const;
+  bool changeStatusOf(int id, bool status) const;
+  int getMaxNumberOfTimeSteps() const;
+  std::string getDftMeshName() const;
+  std::vector< std::pair<int,int> > getTimeStepsOfActivated(int& lev0, std::vector<double>& ts) const;
+  std::vector<std::string> getNames() const { return _full_names; }
+  //
+  static std::string BuildIndexFileName(const std::string& medFileName, const std::string& indexDirectory);
+  static bool GetFileStamp(const std::string& fileName, long long& size, long long& mtime);
+public:
+  std::vector< TimeSeries > _time_series;
+  std::vector< MeshInfo > _meshes;
+private:
+  const Leaf& getTheSingleActivated(int& lev0, int& lev1) const;
+  void checkId(int id) const;
+  static void WriteString(std::ostream& os, const std::string& str);
+  static std::size_t ReadCount(std::istream& is, std::size_t maxCount);
+  static std::string ReadString(std::istream& is, std::size_t maxSize);
+public:
+  static const char HEADER[];
+  static const int VERSION;
+  static const char EXTENSION[];
+private:
+  bool _loaded;
+  //! computed by finalize from _time_series. Ids are numbered following the order of the leaves.
+  std::vector<std::string> _full_names;
+  std::unordered_map<std::string,int> _id_per_name;
+  mutable std::vector<bool> _status;
+};
+
+#endif
@@ -20,12 +20,17 @@
 
 #include "MEDTimeReq.hxx"
 #include "MEDUtilities.hxx"
+#include "vtkGenerateVectors.h"
 
 #include "MEDFileFieldRepresentationTree.hxx"
 #include "MEDCouplingFieldDiscretization.hxx"
 #include "MEDCouplingFieldDouble.hxx"
 #include "InterpKernelGaussCoords.hxx"
+#include "CellModel.hxx"
 #include "MEDFileData.hxx"
+#include "MEDFileMeshReadSelector.hxx"
+#include "MEDFileUtilities.hxx"
+#include "MEDLoader.hxx"
 #include "MEDCouplingMemArray.txx"
 
 #ifdef MEDREADER_USE_MPI
@@ -57,6 +62,12 @@
 #include "vtkCellData.h"
 
 #include "vtkMutableDirectedGraph.h"
+#include "vtkSmartPointer.h"
+
+#include <thread>
+#include <memory>
+#include <exception>
+#include <limits>
 
 using namespace MEDCoupling;
 
@@ -82,6 +93,12 @@ const char MEDFileFieldRepresentationTree::ROOT_OF_FAM_IDS_IN_TREE[]="zeFamIds";
 
 const char MEDFileFieldRepresentationTree::COMPO_STR_TO_LOCATE_MESH_DA[]="-@?|*_";
 
+const int MEDFileFieldRepresentationTree::WEIGHT_OF_POLYHEDRON=32;// size of the face stream of a polyhedron with 8 faces of 4 nodes
+
+const int MEDFileFieldRepresentationTree::WEIGHT_OF_QPOLYGON=12;// quadratic hexagon
+
+const int MEDFileFieldRepresentationTree::WEIGHT_OF_POLYGON=6;// hexagon
+
 template<class T>
 vtkIdTypeArray *ELGACmp::findOrCreate(const MEDCoupling::MEDFileFieldGlobsReal *globs, const std::vector<std::string>& locsReallyUsed, vtkDataArray *vtkd, vtkDataSet *ds, bool& isNew, ExportedTinyInfo *internalInfo) const
 {
@@ -100,10 +117,10 @@ vtkIdTypeArray *ELGACmp::findOrCreate(const MEDCoupling::MEDFileFieldGlobsReal *
 
 vtkIdTypeArray *ELGACmp::isExisting(const std::vector<std::string>& locsReallyUsed, vtkDataArray *vtkd) const
 {
-  std::vector< std::vector<std::string> >::iterator it(std::find(_loc_names.begin(),_loc_names.end(),locsReallyUsed));
-  if(it==_loc_names.end())
+  std::unordered_map<std::string,std::size_t>::const_iterator it(_pos_per_loc_key.find(BuildLocKey(locsReallyUsed)));
+  if(it==_pos_per_loc_key.end())
     return 0;
-  std::size_t pos(std::distance(_loc_names.begin(),it));
+  std::size_t pos((*it).second);
   vtkIdTypeArray *ret(_elgas[pos]);
   vtkInformationQuadratureSchemeDefinitionVectorKey *key(vtkQuadratureSchemeDefinition::DICTIONARY());
   for(std::vector<std::pair< vtkQuadratureSchemeDefinition *, unsigned char > >::const_iterator it=_defs[pos].begin();it!=_defs[pos].end();it++)
@@ -122,17 +139,17 @@ vtkIdTypeArray *ELGACmp::createNew(const MEDCoupling::MEDFileFieldGlobsReal *glo
   std::vector<vtkIdTypeArray *> elgas(_elgas);
   std::vector< std::pair< vtkQuadratureSchemeDefinition *, unsigned char > > defs;
   //
-  std::vector< std::vector<std::string> >::const_iterator it(std::find(locNames.begin(),locNames.end(),locsReallyUsed));
-  if(it!=locNames.end())
+  std::string locKey(BuildLocKey(locsReallyUsed));
+  if(_pos_per_loc_key.find(locKey)!=_pos_per_loc_key.end())
     throw INTERP_KERNEL::Exception("ELGACmp::createNew : Method is expected to be called after isExisting call ! Entry already exists !");
   locNames.push_back(locsReallyUsed);
   vtkIdTypeArray *elga(vtkIdTypeArray::New());
   elga->SetNumberOfComponents(1);
   vtkInformationQuadratureSchemeDefinitionVectorKey *key(vtkQuadratureSchemeDefinition::DICTIONARY());
-  std::map<unsigned char,int> m;
+  vtkIdType nbOfGaussPtPerType[256];
+  std::fill(nbOfGaussPtPerType,nbOfGaussPtPerType+256,0);
   for(std::vector<std::string>::const_iterator it=locsReallyUsed.begin();it!=locsReallyUsed.end();it++)
     {
-      vtkQuadratureSchemeDefinition *def(vtkQuadratureSchemeDefinition::New());
       const MEDFileFieldLoc& loc(globs->getLocalization((*it).c_str()));
       INTERP_KERNEL::NormalizedCellType ct(loc.getGeoType());
       unsigned char vtkType(MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE[ct]);
@@ -143,6 +160,16 @@ vtkIdTypeArray *ELGACmp::createNew(const MEDCoupling::MEDFileFieldGlobsReal *glo
       std::vector<double> refCoods2(INTERP_KERNEL::GaussInfo::NormalizeCoordinatesIfNecessary(ct,dimLoc,loc.getRefCoords()));
       if(internalInfo)
         internalInfo->pushGaussAdditionnalInfo(vtkType,dimLoc,refCoods2,gsCoods2);
+      nbOfGaussPtPerType[vtkType]=nbGaussPt;
+      std::map<std::string,vtkQuadratureSchemeDefinition *>::const_iterator itDef(_def_per_loc.find(*it));
+      if(itDef!=_def_per_loc.end())
+        {// definition already computed for another combination of localizations
+          key->Set(elga->GetInformation(),(*itDef).second,vtkType);
+          key->Set(vtkd->GetInformation(),(*itDef).second,vtkType);
+          defs.push_back(std::pair< vtkQuadratureSchemeDefinition *, unsigned char >((*itDef).second,vtkType));
+          continue;
+        }
+      vtkQuadratureSchemeDefinition *def(vtkQuadratureSchemeDefinition::New());
       double *shape(new double[nbPtsPerCell*nbGaussPt]);
       INTERP_KERNEL::GaussInfo calculator(ct,gsCoods2,nbGaussPt,refCoods2,nbPtsPerCell);
       calculator.initLocalInfo();
@@ -158,24 +185,19 @@ vtkIdTypeArray *ELGACmp::createNew(const MEDCoupling::MEDFileFieldGlobsReal *glo
                 shape[nbPtsPerCell*i+j]=pt0[MEDMeshMultiLev::HEXA27_PERM_ARRAY[j]];
             }
         }
-      m[vtkType]=nbGaussPt;
       def->Initialize(vtkType,nbPtsPerCell,nbGaussPt,shape,const_cast<double *>(&wgths[0]));
       delete [] shape;
       key->Set(elga->GetInformation(),def,vtkType);
       key->Set(vtkd->GetInformation(),def,vtkType);
       defs.push_back(std::pair< vtkQuadratureSchemeDefinition *, unsigned char >(def,vtkType));
+      _def_per_loc[*it]=def;
     }
   //
   vtkIdType ncell(ds->GetNumberOfCells());
-  vtkIdType *pt(new vtkIdType[ncell]),offset(0);
-  for(vtkIdType cellId=0;cellId<ncell;cellId++)
-    {
-      vtkCell *cell(ds->GetCell(cellId));
-      vtkIdType delta(m[(unsigned char)cell->GetCellType()]);
-      pt[cellId]=offset;
-      offset+=delta;
-    }
+  vtkIdType *pt(new vtkIdType[ncell]);
+  ComputeOffsetsFromCellTypes(ds,nbOfGaussPtPerType,pt);
   elga->GetInformation()->Set(MEDUtilities::ELGA(),1);
+  elga->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
   elga->SetVoidArray(pt,ncell,0,VTK_DATA_ARRAY_DELETE);
   std::ostringstream oss; oss << "ELGA" << "@" << _loc_names.size();
   std::string ossStr(oss.str());
@@ -185,24 +207,342 @@ vtkIdTypeArray *ELGACmp::createNew(const MEDCoupling::MEDFileFieldGlobsReal *glo
   elgas.push_back(elga);
   //
   _loc_names=locNames;
+  _pos_per_loc_key[locKey]=_loc_names.size()-1;
   _elgas=elgas;
   _defs.push_back(defs);
   return elga;
 }
 
+/*!
+ * Each name is prefixed by its length so that two different lists of localization names never lead to the same key.
+ */
+std::string ELGACmp::BuildLocKey(const std::vector<std::string>& locsReallyUsed)
+{
+  std::ostringstream oss;
+  for(std::vector<std::string>::const_iterator it=locsReallyUsed.begin();it!=locsReallyUsed.end();it++)
+    oss << (*it).length() << ":" << *it;
+  return oss.str();
+}
+
 void ELGACmp::appendELGAIfAny(vtkDataSet *ds) const
 {
   for(std::vector<vtkIdTypeArray *>::const_iterator it=_elgas.begin();it!=_elgas.end();it++)
     ds->GetCellData()->AddArray(*it);
 }
 
+/*!
+ * Computes in \a offsets the position of the first value of each cell of \a ds in an array having \a nbOfValuesPerType[t] values for each cell of VTK type t.
+ * The types are taken in bulk (types array of unstructured grids, single type of structured datasets) : no vtkCell is instantiated.
+ */
+void ELGACmp::ComputeOffsetsFromCellTypes(vtkDataSet *ds, const vtkIdType nbOfValuesPerType[256], vtkIdType *offsets)
+{
+  vtkIdType ncell(ds->GetNumberOfCells()),offset(0);
+  if(ncell==0)
+    return ;
+  vtkUnstructuredGrid *ug(vtkUnstructuredGrid::SafeDownCast(ds));
+  if(ug)
+    {
+      const unsigned char *types(ug->GetCellTypesArray()->GetPointer(0));
+      for(vtkIdType cellId=0;cellId<ncell;cellId++)
+        {
+          offsets[cellId]=offset;
+          offset+=nbOfValuesPerType[types[cellId]];
+        }
+    }
+  else if(vtkRectilinearGrid::SafeDownCast(ds) || vtkStructuredGrid::SafeDownCast(ds))
+    {// all cells share the same type
+      vtkIdType delta(nbOfValuesPerType[(unsigned char)ds->GetCellType(0)]);
+      for(vtkIdType cellId=0;cellId<ncell;cellId++,offset+=delta)
+        offsets[cellId]=offset;
+    }
+  else
+    {
+      for(vtkIdType cellId=0;cellId<ncell;cellId++)
+        {
+          offsets[cellId]=offset;
+          offset+=nbOfValuesPerType[(unsigned char)ds->GetCellType(cellId)];
+        }
+    }
+}
+
 ELGACmp::~ELGACmp()
 {
   for(std::vector<vtkIdTypeArray *>::const_iterator it=_elgas.begin();it!=_elgas.end();it++)
     (*it)->Delete();
-  for(std::vector< std::vector< std::pair< vtkQuadratureSchemeDefinition *, unsigned char > > >::const_iterator it0=_defs.begin();it0!=_defs.end();it0++)
-    for(std::vector< std::pair< vtkQuadratureSchemeDefinition *, unsigned char > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
-      (*it1).first->Delete();
+  // definitions in _defs are owned by _def_per_loc
+  for(std::map<std::string,vtkQuadratureSchemeDefinition *>::const_iterator it=_def_per_loc.begin();it!=_def_per_loc.end();it++)
+    (*it).second->Delete();
+}
+
+//=
+
+ELNOCache& ELNOCache::operator=(const ELNOCache& other)
+{
+  clear();
+  return *this;
+}
+
+ELNOCache::~ELNOCache()
+{
+  clear();
+}
+
+/*!
+ * Adds to \a ds the offsets array named "ELNO@"+\a name sharing the buffer of the offsets of the support, and links it to \a vtkd.
+ */
+void ELNOCache::attachOffsetsTo(vtkDataArray *vtkd, const std::string& name, vtkDataSet *ds) const
+{
+  if(!_offsets)
+    initialize(ds);
+  vtkIdTypeArray *elno(vtkIdTypeArray::New());
+  elno->ShallowCopy(_offsets);//no copy of data. Name and information are not copied.
+  elno->GetInformation()->Set(MEDUtilities::ELNO(),1);
+  elno->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
+  std::string nameElno("ELNO"); nameElno+="@"; nameElno+=name;
+  elno->SetName(nameElno.c_str());
+  elno->GetInformation()->Set(vtkAbstractArray::GUI_HIDE(),1);
+  ds->GetCellData()->AddArray(elno);
+  vtkd->GetInformation()->Set(vtkQuadratureSchemeDefinition::QUADRATURE_OFFSET_ARRAY_NAME(),elno->GetName());
+  vtkInformationQuadratureSchemeDefinitionVectorKey *key(vtkQuadratureSchemeDefinition::DICTIONARY());
+  for(std::vector< std::pair< vtkQuadratureSchemeDefinition *, unsigned char > >::const_iterator it=_defs.begin();it!=_defs.end();it++)
+    {
+      key->Set(elno->GetInformation(),(*it).first,(*it).second);
+      key->Set(vtkd->GetInformation(),(*it).first,(*it).second);
+    }
+  elno->Delete();
+}
+
+void ELNOCache::clear() const
+{
+  if(_offsets)
+    _offsets->Delete();
+  _offsets=0;
+  for(std::vector< std::pair< vtkQuadratureSchemeDefinition *, unsigned char > >::const_iterator it=_defs.begin();it!=_defs.end();it++)
+    (*it).first->Delete();
+  _defs.clear();
+}
+
+/*!
+ * The offsets of ELNO values are the offsets of the connectivity of each cell. They are taken in bulk from the cell array of unstructured grids.
+ */
+void ELNOCache::initialize(vtkDataSet *ds) const
+{
+  clear();
+  vtkIdType ncell(ds->GetNumberOfCells());
+  vtkIdTypeArray *offsets(vtkIdTypeArray::New());
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(ncell);
+  vtkIdType *pt(offsets->GetPointer(0));
+  bool cellTypes[256];
+  std::fill(cellTypes,cellTypes+256,false);
+  vtkUnstructuredGrid *ug(vtkUnstructuredGrid::SafeDownCast(ds));
+  if(ug)
+    {
+      vtkCellArray *cells(ug->GetCells());
+      for(vtkIdType cellId=0;cellId<ncell;cellId++)
+        pt[cellId]=cells->GetOffset(cellId);
+      const unsigned char *types(ug->GetCellTypesArray()->GetPointer(0));
+      for(vtkIdType cellId=0;cellId<ncell;cellId++)
+        cellTypes[types[cellId]]=true;
+    }
+  else if(ncell>0 && (vtkRectilinearGrid::SafeDownCast(ds) || vtkStructuredGrid::SafeDownCast(ds)))
+    {// all cells share the same type
+      vtkIdType delta(ds->GetCellSize(0)),offset(0);
+      for(vtkIdType cellId=0;cellId<ncell;cellId++,offset+=delta)
+        pt[cellId]=offset;
+      cellTypes[(unsigned char)ds->GetCellType(0)]=true;
+    }
+  else
+    {
+      vtkIdType offset(0);
+      for(vtkIdType cellId=0;cellId<ncell;cellId++)
+        {
+          pt[cellId]=offset;
+          offset+=ds->GetCellSize(cellId);
+          cellTypes[(unsigned char)ds->GetCellType(cellId)]=true;
+        }
+    }
+  _offsets=offsets;
+  //
+  for(int vtkType=0;vtkType<256;vtkType++)
+    {
+      if(!cellTypes[vtkType])
+        continue;
+      const unsigned char *pos(std::find(MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE,MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE+MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE_LGTH,(unsigned char)vtkType));
+      if(pos==MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE+MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE_LGTH)
+        continue;
+      INTERP_KERNEL::NormalizedCellType ct((INTERP_KERNEL::NormalizedCellType)std::distance(MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE,pos));
+      const INTERP_KERNEL::CellModel& cm(INTERP_KERNEL::CellModel::GetCellModel(ct));
+      int nbGaussPt(cm.getNumberOfNodes()),dim(cm.getDimension());
+      vtkQuadratureSchemeDefinition *def(vtkQuadratureSchemeDefinition::New());
+      double *shape(new double[nbGaussPt*nbGaussPt]);
+      std::size_t dummy;
+      const double *gsCoords(MEDCouplingFieldDiscretizationGaussNE::GetRefCoordsFromGeometricType(ct,dummy));//GetLocsFromGeometricType
+      const double *refCoords(MEDCouplingFieldDiscretizationGaussNE::GetRefCoordsFromGeometricType(ct,dummy));
+      const double *weights(MEDCouplingFieldDiscretizationGaussNE::GetWeightArrayFromGeometricType(ct,dummy));
+      std::vector<double> gsCoords2(gsCoords,gsCoords+nbGaussPt*dim),refCoords2(refCoords,refCoords+nbGaussPt*dim);
+      INTERP_KERNEL::GaussInfo calculator(ct,gsCoords2,nbGaussPt,refCoords2,nbGaussPt);
+      calculator.initLocalInfo();
+      for(int i=0;i<nbGaussPt;i++)
+        {
+          const double *pt0(calculator.getFunctionValues(i));
+          std::copy(pt0,pt0+nbGaussPt,shape+nbGaussPt*i);
+        }
+      def->Initialize(vtkType,nbGaussPt,nbGaussPt,shape,const_cast<double *>(weights));
+      delete [] shape;
+      _defs.push_back(std::pair< vtkQuadratureSchemeDefinition *, unsigned char >(def,(unsigned char)vtkType));
+    }
+}
+
+//=
+
+DataSetLRUCache::DataSetLRUCache():_size_limit_in_mb(0),_size_in_kb(0),_nb_of_hits(0),_nb_of_misses(0)
+{
+}
+
+DataSetLRUCache::~DataSetLRUCache()
+{
+  clear();
+}
+
+/*!
+ * \param [in] sizeInMB - the memory budget of the cache. 0 (or negative) disables the cache and releases all the entries.
+ */
+void DataSetLRUCache::setSizeLimit(int sizeInMB) const
+{
+  _size_limit_in_mb=std::max(sizeInMB,0);
+  evictIfNecessary();
+}
+
+/*!
+ * \return a new instance (to be deallocated by the caller) sharing the arrays of the entry \a key, or 0 if not in cache.
+ */
+vtkDataSet *DataSetLRUCache::retrieve(const std::string& key) const
+{
+  std::map<std::string,EntriesType::iterator>::iterator it(_index.find(key));
+  if(it==_index.end())
+    {
+      _nb_of_misses++;
+      return 0;
+    }
+  _nb_of_hits++;
+  _entries.splice(_entries.begin(),_entries,(*it).second);
+  vtkDataSet *ret((*(*it).second).second.first->NewInstance());
+  ret->ShallowCopy((*(*it).second).second.first);
+  return ret;
+}
+
+/*!
+ * \a ds is not stolen. A shallow copy of it is kept so that the caller is free to add or remove arrays on \a ds.
+ */
+void DataSetLRUCache::store(const std::string& key, vtkDataSet *ds) const
+{
+  if(!isActivated() || !ds)
+    return ;
+  std::map<std::string,EntriesType::iterator>::iterator it(_index.find(key));
+  if(it!=_index.end())
+    {
+      _size_in_kb-=(*(*it).second).second.second;
+      (*(*it).second).second.first->Delete();
+      _entries.erase((*it).second);
+      _index.erase(it);
+    }
+  vtkDataSet *entry(ds->NewInstance());
+  entry->ShallowCopy(ds);
+  unsigned long sizeInKB(ComputeSizeInKB(entry));
+  _entries.push_front(std::pair<std::string, std::pair<vtkDataSet *,unsigned long> >(key,std::pair<vtkDataSet *,unsigned long>(entry,sizeInKB)));
+  _index[key]=_entries.begin();
+  _size_in_kb+=sizeInKB;
+  evictIfNecessary();
+}
+
+void DataSetLRUCache::clear() const
+{
+  for(EntriesType::const_iterator it=_entries.begin();it!=_entries.end();it++)
+    (*it).second.first->Delete();
+  _entries.clear();
+  _index.clear();
+  _size_in_kb=0;
+}
+
+/*!
+ * Only the arrays owned by \a ds are accounted. The geometry of all the datasets of a leaf is shared with MEDFileFieldRepresentationLeaves::_cached_ds,
+ * and the arrays flagged with MEDUtilities::SHARED_MEMORY are either kept by the leaf or point to memory of MEDCoupling.
+ */
+unsigned long DataSetLRUCache::ComputeSizeInKB(vtkDataSet *ds)
+{
+  unsigned long ret(0);
+  vtkFieldData *atts[3]={ds->GetPointData(),ds->GetCellData(),ds->GetFieldData()};
+  for(int i=0;i<3;i++)
+    for(int j=0;j<atts[i]->GetNumberOfArrays();j++)
+      {
+        vtkAbstractArray *arr(atts[i]->GetAbstractArray(j));
+        if(!arr || (arr->HasInformation() && arr->GetInformation()->Has(MEDUtilities::SHARED_MEMORY())))
+          continue;
+        ret+=arr->GetActualMemorySize();
+      }
+  return ret;
+}
+
+void DataSetLRUCache::evictIfNecessary() const
+{
+  unsigned long limitInKB((unsigned long)_size_limit_in_mb*1024);
+  while(!_entries.empty() && _size_in_kb>limitInKB)
+    {
+      std::pair<std::string, std::pair<vtkDataSet *,unsigned long> >& lru(_entries.back());
+      _size_in_kb-=lru.second.second;
+      lru.second.first->Delete();
+      _index.erase(lru.first);
+      _entries.pop_back();
+    }
+}
+
+StructuredCoordsCache::~StructuredCoordsCache()
+{
+  clear();
+}
+
+/*!
+ * \param [in] nbOfTuples - the expected number of tuples of each array. Entries not matching them are ignored.
+ * \return new references (to be deleted by the caller) on the arrays of \a meshName, or an empty vector if not in cache.
+ */
+std::vector<vtkDataArray *> StructuredCoordsCache::retrieve(const std::string& meshName, bool singlePrecision, const std::vector<vtkIdType>& nbOfTuples) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::vector<vtkDataArray *> ret;
+  std::map< std::pair<std::string,bool>, std::vector<vtkDataArray *> >::const_iterator it(_arrays.find(std::pair<std::string,bool>(meshName,singlePrecision)));
+  if(it==_arrays.end() || (*it).second.size()!=nbOfTuples.size())
+    return ret;
+  for(std::size_t i=0;i<nbOfTuples.size();i++)
+    if((*it).second[i]->GetNumberOfTuples()!=nbOfTuples[i])
+      return ret;
+  ret=(*it).second;
+  for(std::vector<vtkDataArray *>::const_iterator it2=ret.begin();it2!=ret.end();it2++)
+    (*it2)->Register(0);
+  return ret;
+}
+
+/*!
+ * \a arrs are not stolen. Nothing is done if \a meshName is already in cache.
+ */
+void StructuredCoordsCache::store(const std::string& meshName, bool singlePrecision, const std::vector<vtkDataArray *>& arrs) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::vector<vtkDataArray *>& entry(_arrays[std::pair<std::string,bool>(meshName,singlePrecision)]);
+  if(!entry.empty())
+    return ;
+  entry=arrs;
+  for(std::vector<vtkDataArray *>::const_iterator it=entry.begin();it!=entry.end();it++)
+    (*it)->Register(0);
+}
+
+void StructuredCoordsCache::clear() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for(std::map< std::pair<std::string,bool>, std::vector<vtkDataArray *> >::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
+    for(std::vector<vtkDataArray *>::const_iterator it2=(*it).second.begin();it2!=(*it).second.end();it2++)
+      (*it2)->Delete();
+  _arrays.clear();
 }
 
 //=
@@ -262,7 +602,10 @@ template<class T>
 void AssignDataPointerToVTK(typename MEDFileVTKTraits<T>::VtkType *vtkTab, typename MEDFileVTKTraits<T>::MCType *mcTab, bool noCpyNumNodes)
 {
   if(noCpyNumNodes)
-    vtkTab->SetArray(mcTab->getPointer(),mcTab->getNbOfElems(),1,vtkAOSDataArrayTemplate<T>::VTK_DATA_ARRAY_FREE);
+    {
+      vtkTab->SetArray(mcTab->getPointer(),mcTab->getNbOfElems(),1,vtkAOSDataArrayTemplate<T>::VTK_DATA_ARRAY_FREE);
+      vtkTab->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
+    }
  else
    { vtkTab->SetArray(mcTab->getPointer(),mcTab->getNbOfElems(),0,vtkAOSDataArrayTemplate<T>::VTK_DATA_ARRAY_FREE); mcTab->accessToMemArray().setSpecificDeallocator(0); }
 }
@@ -285,84 +628,196 @@ void AssignDataPointerOther(VTKT *vtkTab, MCT *mcTab, vtkIdType nbElems)
     }
 }
 
+/*!
+ * One time step of one array, read and converted (possibly concurrently with others) before being attached to the dataset.
+ */
+class FieldArrayToAttach
+{
+public:
+  FieldArrayToAttach():_no_cpy(false),_single_precision(false),_disc(ON_CELLS) { }
+public:
+  MCAuto<MEDFileAnyTypeField1TS> _f1ts;
+  MCAuto<DataArray> _arr;
+  //! true if _arr is the array of _f1ts itself.
+  bool _no_cpy;
+  //! true if a FLOAT64 array has to be converted into FLOAT32.
+  bool _single_precision;
+  std::string _name;
+  //! VTK array wrapping _arr, built by loadField.
+  vtkSmartPointer<vtkDataArray> _vtk_arr;
+  TypeOfField _disc;
+};
+
+/*!
+ * Returns a new VTK array of \a nbOfCompo components holding \a mcTab. Without copy (see AssignDataPointerToVTK) in double precision,
+ * converted into a float array in single precision.
+ */
+vtkDataArray *BuildVTKArrayOfCoords(DataArrayDouble *mcTab, bool noCpy, int nbOfCompo, bool singlePrecision)
+{
+  if(!singlePrecision)
+    {
+      vtkDoubleArray *ret(vtkDoubleArray::New());
+      ret->SetNumberOfComponents(nbOfCompo);
+      AssignDataPointerToVTK<double>(ret,mcTab,noCpy);
+      return ret;
+    }
+  MCAuto<DataArrayFloat> mcTabF(mcTab->convertToFloatArr());
+  vtkFloatArray *ret(vtkFloatArray::New());
+  ret->SetNumberOfComponents(nbOfCompo);
+  AssignDataPointerToVTK<float>(ret,mcTabF,false);
+  return ret;
+}
+
+/*!
+ * Returns a new VTK array holding \a mcTab. If \a narrow is true and if the values fit, the array is converted into an int32 array.
+ */
+vtkDataArray *BuildVTKArrayOfIds(DataArrayIdType *mcTab, bool noCpy, bool narrow)
+{
+  if(narrow && sizeof(mcIdType)>sizeof(int) && mcTab->getNbOfElems()>0)
+    {
+      mcIdType minVal(mcTab->getMinValueInArray()),maxVal(mcTab->getMaxValueInArray());
+      if(minVal>=(mcIdType)std::numeric_limits<int>::min() && maxVal<=(mcIdType)std::numeric_limits<int>::max())
+        {
+          vtkIntArray *ret(vtkIntArray::New());
+          ret->SetNumberOfComponents(1);
+          ret->SetNumberOfTuples(mcTab->getNbOfElems());
+          std::copy(mcTab->begin(),mcTab->end(),ret->GetPointer(0));
+          return ret;
+        }
+    }
+  vtkMCIdTypeArray *ret(vtkMCIdTypeArray::New());
+  ret->SetNumberOfComponents(1);
+  AssignDataPointerToVTK<mcIdType>(ret,mcTab,noCpy);
+  return ret;
+}
+
+/*!
+ * Runs \a task on [0,nbOfTasks) using at most \a nbOfThreads threads. The first exception thrown by a task is rethrown in the calling thread.
+ */
+template<class TASK>
+void ExecuteConcurrently(int nbOfThreads, std::size_t nbOfTasks, TASK task)
+{
+  std::size_t nbOfWorkers(std::min((std::size_t)std::max(nbOfThreads,1),nbOfTasks));
+  if(nbOfWorkers<=1)
+    {
+      for(std::size_t i=0;i<nbOfTasks;i++)
+        task(i);
+      return ;
+    }
+  std::atomic<std::size_t> next(0);
+  std::vector<std::exception_ptr> errors(nbOfWorkers);
+  std::vector<std::thread> workers;
+  for(std::size_t w=0;w<nbOfWorkers;w++)
+    workers.push_back(std::thread([&next,&errors,&task,nbOfTasks,w]()
+      {
+        try
+          {
+            for(std::size_t i=next++;i<nbOfTasks;i=next++)
+              task(i);
+          }
+        catch(...)
+          {
+            errors[w]=std::current_exception();
+            next=nbOfTasks;
+          }
+      }));
+  for(std::vector<std::thread>::iterator it=workers.begin();it!=workers.end();it++)
+    (*it).join();
+  for(std::vector<std::exception_ptr>::const_iterator it=errors.begin();it!=errors.end();it++)
+    if(*it)
+      std::rethrow_exception(*it);
+}
+
+/*!
+ * Mutex protecting the MEDCoupling objects shared by all the arrays of a leaf (globals, mesh structure and multi level mesh)
+ * during a concurrent load : their reference counters are not atomic.
+ */
+static std::mutex& GetSharedMEDCouplingObjectsMutex()
+{
+  static std::mutex ret;
+  return ret;
+}
+
+/*!
+ * Returns a new VTK array named \a name holding the values of \a vPtr (see AssignDataPointerToVTK).
+ */
 template<class T>
-void AssignToFieldData(DataArray *vPtr, const MEDTimeReq *tr, vtkFieldData *att, const std::string& crudeName, bool noCpyNumNodes,
-                       const std::vector<TypeOfField>& discs, const ELGACmp& elgaCmp, const MEDCoupling::MEDFileFieldGlobsReal *globs,
-                       MEDFileAnyTypeField1TS *f1ts, vtkDataSet *ds, ExportedTinyInfo *internalInfo)
+vtkDataArray *BuildVTKArrayOfField(DataArray *vPtr, const std::string& name, bool noCpyNumNodes)
 {
-  const int VTK_DATA_ARRAY_DELETE=vtkAOSDataArrayTemplate<T>::VTK_DATA_ARRAY_DELETE;
   typename MEDFileVTKTraits<T>::MCType *vi(static_cast<typename MEDFileVTKTraits<T>::MCType *>(vPtr));
   typename MEDFileVTKTraits<T>::VtkType *vtkd(MEDFileVTKTraits<T>::VtkType::New());
   vtkd->SetNumberOfComponents((int)vi->getNumberOfComponents());
   for(unsigned int i=0;i<vi->getNumberOfComponents();i++)
     vtkd->SetComponentName(i,vi->getVarOnComponent(i).c_str());
   AssignDataPointerToVTK<T>(vtkd,vi,noCpyNumNodes);
-  std::string name(tr->buildName(crudeName));
   vtkd->SetName(name.c_str());
-  att->AddArray(vtkd);
-  vtkd->Delete();
-  if(discs[0]==ON_GAUSS_PT)
-    {
-      bool tmp;
-      elgaCmp.findOrCreate<T>(globs,f1ts->getLocsReallyUsed(),vtkd,ds,tmp,internalInfo);
-    }
-  if(discs[0]==ON_GAUSS_NE)
-    {
-      vtkIdTypeArray *elno(vtkIdTypeArray::New());
-      elno->SetNumberOfComponents(1);
-      vtkIdType ncell(ds->GetNumberOfCells());
-      vtkIdType *pt(new vtkIdType[ncell]),offset(0);
-      std::set<int> cellTypes;
-      for(vtkIdType cellId=0;cellId<ncell;cellId++)
-        {
-          vtkCell *cell(ds->GetCell(cellId));
-          vtkIdType delta(cell->GetNumberOfPoints());
-          cellTypes.insert(cell->GetCellType());
-          pt[cellId]=offset;
-          offset+=delta;
-        }
-      elno->GetInformation()->Set(MEDUtilities::ELNO(),1);
-      elno->SetVoidArray(pt,ncell,0,VTK_DATA_ARRAY_DELETE);
-      std::string nameElno("ELNO"); nameElno+="@"; nameElno+=name;
-      elno->SetName(nameElno.c_str());
-      ds->GetCellData()->AddArray(elno);
-      vtkd->GetInformation()->Set(vtkQuadratureSchemeDefinition::QUADRATURE_OFFSET_ARRAY_NAME(),elno->GetName());
-      elno->GetInformation()->Set(vtkAbstractArray::GUI_HIDE(),1);
-      //
-      vtkInformationQuadratureSchemeDefinitionVectorKey *key(vtkQuadratureSchemeDefinition::DICTIONARY());
-      for(std::set<int>::const_iterator it=cellTypes.begin();it!=cellTypes.end();it++)
-        {
-          const unsigned char *pos(std::find(MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE,MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE+MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE_LGTH,*it));
-          if(pos==MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE+MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE_LGTH)
-            continue;
-          INTERP_KERNEL::NormalizedCellType ct((INTERP_KERNEL::NormalizedCellType)std::distance(MEDMeshMultiLev::PARAMEDMEM_2_VTKTYPE,pos));
-          const INTERP_KERNEL::CellModel& cm(INTERP_KERNEL::CellModel::GetCellModel(ct));
-          int nbGaussPt(cm.getNumberOfNodes()),dim(cm.getDimension());
-          vtkQuadratureSchemeDefinition *def(vtkQuadratureSchemeDefinition::New());
-          double *shape(new double[nbGaussPt*nbGaussPt]);
-          std::size_t dummy;
-          const double *gsCoords(MEDCouplingFieldDiscretizationGaussNE::GetRefCoordsFromGeometricType(ct,dummy));//GetLocsFromGeometricType
-          const double *refCoords(MEDCouplingFieldDiscretizationGaussNE::GetRefCoordsFromGeometricType(ct,dummy));
-          const double *weights(MEDCouplingFieldDiscretizationGaussNE::GetWeightArrayFromGeometricType(ct,dummy));
-          std::vector<double> gsCoords2(gsCoords,gsCoords+nbGaussPt*dim),refCoords2(refCoords,refCoords+nbGaussPt*dim);
-          INTERP_KERNEL::GaussInfo calculator(ct,gsCoords2,nbGaussPt,refCoords2,nbGaussPt);
-          calculator.initLocalInfo();
-          for(int i=0;i<nbGaussPt;i++)
-            {
-              const double *pt0(calculator.getFunctionValues(i));
-              std::copy(pt0,pt0+nbGaussPt,shape+nbGaussPt*i);
-            }
-          def->Initialize(*it,nbGaussPt,nbGaussPt,shape,const_cast<double *>(weights));
-          delete [] shape;
-          key->Set(elno->GetInformation(),def,*it);
-          key->Set(vtkd->GetInformation(),def,*it);
-          def->Delete();
-        }
-      //
-      elno->Delete();
-    }
+  return vtkd;
+}
+
+/*!
+ * Links the ELGA field \a vtkd to its offsets, computed by \a elgaCmp if not already done for the same localizations.
+ */
+template<class T>
+void ComputeELGAOffsetsOf(vtkDataArray *vtkd, const ELGACmp& elgaCmp, const MEDCoupling::MEDFileFieldGlobsReal *globs, MEDFileAnyTypeField1TS *f1ts,
+                          vtkDataSet *ds, ExportedTinyInfo *internalInfo, MEDReaderTimings *timings)
+{
+  bool isNew(false);
+  MEDReaderStageTimer timer(timings,MEDReaderTimings::ELGA_OFFSETS);
+  vtkIdTypeArray *offsets(elgaCmp.findOrCreate<T>(globs,f1ts->getLocsReallyUsed(),vtkd,ds,isNew,internalInfo));
+  if(isNew && offsets)
+    timer.setNumberOfBytes(1024ULL*offsets->GetActualMemorySize());
+  else
+    timer.cancel();
 }
 
+/*!
+ * Calls \a func with a null pointer of the type of the values of \a item once loaded : double, float, int or Int64.
+ */
+template<class FUNC>
+void DispatchOnValueType(const FieldArrayToAttach& item, const FUNC& func)
+{
+  MEDFileAnyTypeField1TS *f1ts(item._f1ts);
+  DataArray *v(item._arr);
+  if(dynamic_cast<MEDFileField1TS *>(f1ts) && dynamic_cast<DataArrayFloat *>(v))
+    func((float *)0);// FLOAT64 field converted by loadField
+  else if(dynamic_cast<MEDFileField1TS *>(f1ts))
+    func((double *)0);
+  else if(dynamic_cast<MEDFileInt32Field1TS *>(f1ts))
+    func((int *)0);
+  else if(dynamic_cast<MEDFileFloatField1TS *>(f1ts))
+    func((float *)0);
+  else if(dynamic_cast<MEDFileInt64Field1TS *>(f1ts))
+    func((Int64 *)0);
+  else
+    throw INTERP_KERNEL::Exception("DispatchOnValueType : only FLOAT64, FLOAT32, INT32 and INT64 fields are dealt for the moment ! Internal Error !");
+}
+
+class VTKArrayOfFieldBuilder
+{
+public:
+  VTKArrayOfFieldBuilder(FieldArrayToAttach& item):_item(item) { }
+  template<class T>
+  void operator()(T *) const { _item._vtk_arr.TakeReference(BuildVTKArrayOfField<T>(_item._arr,_item._name,_item._no_cpy)); }
+private:
+  FieldArrayToAttach& _item;
+};
+
+class ELGAOffsetsComputer
+{
+public:
+  ELGAOffsetsComputer(const FieldArrayToAttach& item, const ELGACmp& elgaCmp, const MEDCoupling::MEDFileFieldGlobsReal *globs, vtkDataSet *ds, ExportedTinyInfo *internalInfo, MEDReaderTimings *timings):
+    _item(item),_elga_cmp(elgaCmp),_globs(globs),_ds(ds),_internal_info(internalInfo),_timings(timings) { }
+  template<class T>
+  void operator()(T *) const { ComputeELGAOffsetsOf<T>(_item._vtk_arr,_elga_cmp,_globs,_item._f1ts,_ds,_internal_info,_timings); }
+private:
+  const FieldArrayToAttach& _item;
+  const ELGACmp& _elga_cmp;
+  const MEDCoupling::MEDFileFieldGlobsReal *_globs;
+  vtkDataSet *_ds;
+  ExportedTinyInfo *_internal_info;
+  MEDReaderTimings *_timings;
+};
+
 //=
 
 MEDFileFieldRepresentationLeavesArrays::MEDFileFieldRepresentationLeavesArrays():_id(-1)
@@ -441,107 +896,159 @@ bool MEDFileFieldRepresentationLeavesArrays::setStatus(bool status) const
   return ret;
 }
 
-void MEDFileFieldRepresentationLeavesArrays::appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, vtkDataSet *ds, ExportedTinyInfo *internalInfo) const
+void MEDFileFieldRepresentationLeavesArrays::appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, vtkDataSet *ds, const ELNOCache& elnoCache, ExportedTinyInfo *internalInfo, bool singlePrecision, MEDReaderTimings *timings) const
 {
-  //const int VTK_DATA_ARRAY_DELETE=vtkDataArrayTemplate<double>::VTK_DATA_ARRAY_DELETE; // todo: unused
-  tr->setNumberOfTS((operator->())->getNumberOfTS());
-  tr->initIterator();
-  for(int timeStepId=0;timeStepId<tr->size();timeStepId++,++(*tr))
+  std::vector<FieldArrayToAttach> items;
+  prepareFields(tr,items,singlePrecision);
+  for(std::vector<FieldArrayToAttach>::iterator it=items.begin();it!=items.end();it++)
     {
-      MCAuto<MEDFileAnyTypeField1TS> f1ts((operator->())->getTimeStepAtPos(tr->getCurrent()));
-      MEDFileAnyTypeField1TS *f1tsPtr(f1ts);
-      MEDFileField1TS *f1tsPtrDbl(dynamic_cast<MEDFileField1TS *>(f1tsPtr));
-      MEDFileInt32Field1TS *f1tsPtrInt(dynamic_cast<MEDFileInt32Field1TS *>(f1tsPtr));
-      MEDFileInt64Field1TS *f1tsPtrInt64(dynamic_cast<MEDFileInt64Field1TS *>(f1tsPtr));
-      MEDFileFloatField1TS *f1tsPtrFloat(dynamic_cast<MEDFileFloatField1TS *>(f1tsPtr));
-      DataArray *crudeArr(0),*postProcessedArr(0);
-      if(f1tsPtrDbl)
-        crudeArr=f1tsPtrDbl->getUndergroundDataArray();
-      else if(f1tsPtrInt)
-        crudeArr=f1tsPtrInt->getUndergroundDataArray();
-      else if(f1tsPtrInt64)
-        crudeArr=f1tsPtrInt64->getUndergroundDataArray();
-      else if(f1tsPtrFloat)
-        crudeArr=f1tsPtrFloat->getUndergroundDataArray();
-      else
-        throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeavesArrays::appendFields : only FLOAT64, FLOAT32 and INT32 fields are dealt for the moment !");
-      MEDFileField1TSStructItem fsst(MEDFileField1TSStructItem::BuildItemFrom(f1ts,mst));
-      f1ts->loadArraysIfNecessary();
-      MCAuto<DataArray> v(mml->buildDataArray(fsst,globs,crudeArr));
-      postProcessedArr=v;
-      //
-      std::vector<TypeOfField> discs(f1ts->getTypesOfFieldAvailable());
-      if(discs.size()!=1)
-        throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeavesArrays::appendFields : internal error ! Number of spatial discretizations must be equal to one !");
-      vtkFieldData *att(0);
-      switch(discs[0])
-        {
-        case ON_CELLS:
-          {
-            att=ds->GetCellData();
-            break;
-          }
-        case ON_NODES:
-          {
-            att=ds->GetPointData();
-            break;
-          }
-        case ON_GAUSS_NE:
-          {
-            att=ds->GetFieldData();
-            break;
-          }
-        case ON_GAUSS_PT:
-          {
-            att=ds->GetFieldData();
-            break;
-          }
-        default:
-          throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeavesArrays::appendFields : only CELL and NODE, GAUSS_NE and GAUSS fields are available for the moment !");
-        }
-      if(f1tsPtrDbl)
-        {
-          AssignToFieldData<double>(v,tr,att,f1ts->getName(),postProcessedArr==crudeArr,discs,_elga_cmp,globs,f1ts,ds,internalInfo);
-        }
-      else if(f1tsPtrInt)
-        {
-          AssignToFieldData<int>(v,tr,att,f1ts->getName(),postProcessedArr==crudeArr,discs,_elga_cmp,globs,f1ts,ds,internalInfo);
-        }
-      else if(f1tsPtrFloat)
-        {
-          AssignToFieldData<float>(v,tr,att,f1ts->getName(),postProcessedArr==crudeArr,discs,_elga_cmp,globs,f1ts,ds,internalInfo);
-        }
-      else if(f1tsPtrInt64)
-        {
-          AssignToFieldData<Int64>(v,tr,att,f1ts->getName(),postProcessedArr==crudeArr,discs,_elga_cmp,globs,f1ts,ds,internalInfo);
-        }
-      else
-        throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeavesArrays::appendFields : only FLOAT64 and INT32 fields are dealt for the moment ! Internal Error !");
+      loadField(globs,mml,mst,*it,timings);
+      computeOffsets(*it,globs,ds,internalInfo,timings);
+      attachField(*it,ds,elnoCache);
     }
 }
 
-void MEDFileFieldRepresentationLeavesArrays::appendELGAIfAny(vtkDataSet *ds) const
+/*!
+ * Sequential part. Selects the time steps requested by \a tr and computes the names of the VTK arrays.
+ */
+void MEDFileFieldRepresentationLeavesArrays::prepareFields(const MEDTimeReq *tr, std::vector<FieldArrayToAttach>& items, bool singlePrecision) const
+{
+  tr->setNumberOfTS((operator->())->getNumberOfTS());
+  tr->initIterator();
+  items.resize(tr->size());
+  for(int timeStepId=0;timeStepId<tr->size();timeStepId++,++(*tr))
+    {
+      items[timeStepId]._f1ts=(operator->())->getTimeStepAtPos(tr->getCurrent());
+      items[timeStepId]._name=tr->buildName(items[timeStepId]._f1ts->getName());
+      items[timeStepId]._single_precision=singlePrecision;
+    }
+}
+
+/*!
+ * Part that can be run concurrently on different items : read, conversion into single precision and wrapping into a VTK array.
+ * Only the HDF5 read is serialized behind MEDFileFieldRepresentationTree::GetHDF5Mutex. The calls to MEDCoupling using \a globs, \a mml
+ * and \a mst, shared by all the items, are serialized behind another mutex : the reference counters of MEDCoupling are not atomic.
+ */
+void MEDFileFieldRepresentationLeavesArrays::loadField(const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, FieldArrayToAttach& item, MEDReaderTimings *timings) const
+{
+  MEDFileAnyTypeField1TS *f1tsPtr(item._f1ts);
+  MEDFileField1TS *f1tsPtrDbl(dynamic_cast<MEDFileField1TS *>(f1tsPtr));
+  MEDFileInt32Field1TS *f1tsPtrInt(dynamic_cast<MEDFileInt32Field1TS *>(f1tsPtr));
+  MEDFileInt64Field1TS *f1tsPtrInt64(dynamic_cast<MEDFileInt64Field1TS *>(f1tsPtr));
+  MEDFileFloatField1TS *f1tsPtrFloat(dynamic_cast<MEDFileFloatField1TS *>(f1tsPtr));
+  DataArray *crudeArr(0);
+  if(f1tsPtrDbl)
+    crudeArr=f1tsPtrDbl->getUndergroundDataArray();
+  else if(f1tsPtrInt)
+    crudeArr=f1tsPtrInt->getUndergroundDataArray();
+  else if(f1tsPtrInt64)
+    crudeArr=f1tsPtrInt64->getUndergroundDataArray();
+  else if(f1tsPtrFloat)
+    crudeArr=f1tsPtrFloat->getUndergroundDataArray();
+  else
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeavesArrays::loadField : only FLOAT64, FLOAT32 and INT32 fields are dealt for the moment !");
+  std::vector<TypeOfField> discs(item._f1ts->getTypesOfFieldAvailable());
+  if(discs.size()!=1)
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeavesArrays::loadField : internal error ! Number of spatial discretizations must be equal to one !");
+  if(discs[0]!=ON_CELLS && discs[0]!=ON_NODES && discs[0]!=ON_GAUSS_NE && discs[0]!=ON_GAUSS_PT)
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeavesArrays::loadField : only CELL and NODE, GAUSS_NE and GAUSS fields are available for the moment !");
+  item._disc=discs[0];
+  {
+    std::lock_guard<std::mutex> lock(MEDFileFieldRepresentationTree::GetHDF5Mutex());
+    MEDReaderStageTimer timer(timings,MEDReaderTimings::ARRAY_READ);
+    item._f1ts->loadArraysIfNecessary();
+    timer.setNumberOfBytes(crudeArr->getHeapMemorySizeWithoutChildren());
+  }
+  {
+    std::lock_guard<std::mutex> lock(GetSharedMEDCouplingObjectsMutex());
+    MEDFileField1TSStructItem fsst(MEDFileField1TSStructItem::BuildItemFrom(item._f1ts,mst));
+    item._arr=mml->buildDataArray(fsst,globs,crudeArr);
+  }
+  item._no_cpy=((DataArray *)item._arr)==crudeArr;
+  if(item._single_precision && f1tsPtrDbl)
+    {// conversion in one pass. The array of the field is not touched.
+      DataArrayDouble *arrDbl(static_cast<DataArrayDouble *>((DataArray *)item._arr));
+      item._arr=arrDbl->convertToFloatArr();
+      item._no_cpy=false;
+    }
+  DispatchOnValueType(item,VTKArrayOfFieldBuilder(item));
+}
+
+/*!
+ * Computes the offsets of \a item if it is an ELGA field. \a ds is only read. Can be run concurrently with the computeOffsets of other
+ * arrays (each array having its own ELGACmp), as long as they do not share \a internalInfo. The time steps of an array have to be dealt
+ * in order so that the names of the offsets do not depend on the scheduling.
+ */
+void MEDFileFieldRepresentationLeavesArrays::computeOffsets(const FieldArrayToAttach& item, const MEDCoupling::MEDFileFieldGlobsReal *globs, vtkDataSet *ds, ExportedTinyInfo *internalInfo, MEDReaderTimings *timings) const
+{
+  if(item._disc==ON_GAUSS_PT)
+    DispatchOnValueType(item,ELGAOffsetsComputer(item,_elga_cmp,globs,ds,internalInfo,timings));
+}
+
+/*!
+ * Sequential part. Attaches the array of \a item to the right attributes of \a ds.
+ */
+void MEDFileFieldRepresentationLeavesArrays::attachField(const FieldArrayToAttach& item, vtkDataSet *ds, const ELNOCache& elnoCache) const
+{
+  vtkFieldData *att(0);
+  switch(item._disc)
+    {
+    case ON_CELLS:
+      {
+        att=ds->GetCellData();
+        break;
+      }
+    case ON_NODES:
+      {
+        att=ds->GetPointData();
+        break;
+      }
+    default:
+      {// ON_GAUSS_NE and ON_GAUSS_PT
+        att=ds->GetFieldData();
+        break;
+      }
+    }
+  att->AddArray(item._vtk_arr);
+  if(item._disc==ON_GAUSS_NE)
+    elnoCache.attachOffsetsTo(item._vtk_arr,item._name,ds);
+}
+
+void MEDFileFieldRepresentationLeavesArrays::appendELGAIfAny(vtkDataSet *ds) const
 {
   _elga_cmp.appendELGAIfAny(ds);
 }
 
 ////////////////////
 
-MEDFileFieldRepresentationLeaves::MEDFileFieldRepresentationLeaves():_cached_ds(0)
+MEDFileFieldRepresentationLeaves::MEDFileFieldRepresentationLeaves():_cached_ds(0),_cached_single_precision(false)
 {
 }
 
 MEDFileFieldRepresentationLeaves::MEDFileFieldRepresentationLeaves(const std::vector< MEDCoupling::MCAuto<MEDCoupling::MEDFileAnyTypeFieldMultiTS> >& arr,
-                                                                   const MEDCoupling::MCAuto<MEDCoupling::MEDFileFastCellSupportComparator>& fsp):_arrays(arr.size()),_fsp(fsp),_cached_ds(0)
+                                                                   const MEDCoupling::MCAuto<MEDCoupling::MEDFileFastCellSupportComparator>& fsp):_arrays(arr.size()),_fsp(fsp),_cached_ds(0),_cached_single_precision(false)
 {
   for(std::size_t i=0;i<arr.size();i++)
     _arrays[i]=MEDFileFieldRepresentationLeavesArrays(arr[i]);
 }
 
 MEDFileFieldRepresentationLeaves::~MEDFileFieldRepresentationLeaves()
+{
+  clearMeshSupport();
+}
+
+void MEDFileFieldRepresentationLeaves::clearMeshSupport() const
 {
   if(_cached_ds)
     _cached_ds->Delete();
+  _cached_ds=0;
+  for(std::vector<vtkDataArray *>::const_iterator it=_cached_cell_arrs.begin();it!=_cached_cell_arrs.end();it++)
+    (*it)->Delete();
+  _cached_cell_arrs.clear();
+  for(std::vector<vtkDataArray *>::const_iterator it=_cached_node_arrs.begin();it!=_cached_node_arrs.end();it++)
+    (*it)->Delete();
+  _cached_node_arrs.clear();
+  _cached_mml=0; _cached_mml2=0; _cached_mst=0;
 }
 
 bool MEDFileFieldRepresentationLeaves::empty() const
@@ -561,6 +1068,34 @@ std::string MEDFileFieldRepresentationLeaves::getMeshName() const
   return _arrays[0]->getMeshName();
 }
 
+/*!
+ * Identifies the support built by buildMeshSupportIfNeeded : mesh, first array and its first time step.
+ */
+std::string MEDFileFieldRepresentationLeaves::getSupportKey() const
+{
+  std::vector< std::pair<int,int> > its(_arrays[0]->getIterations());
+  std::ostringstream oss; oss << getMeshName() << MEDFileFieldRepresentationLeavesArrays::ZE_SEP << _arrays[0]->getName();
+  if(!its.empty())
+    oss << MEDFileFieldRepresentationLeavesArrays::ZE_SEP << its[0].first << "," << its[0].second;
+  return oss.str();
+}
+
+/*!
+ * Takes the support already built by \a other (that must have the same support key). \a other has no support anymore after the call.
+ */
+void MEDFileFieldRepresentationLeaves::takeMeshSupportFrom(const MEDFileFieldRepresentationLeaves& other) const
+{
+  clearMeshSupport();
+  if(!other._cached_ds)
+    return ;
+  std::swap(_cached_ds,other._cached_ds);
+  _cached_single_precision=other._cached_single_precision;
+  _cached_mml=other._cached_mml; _cached_mml2=other._cached_mml2; _cached_mst=other._cached_mst;
+  _cached_cell_arrs.swap(other._cached_cell_arrs);
+  _cached_node_arrs.swap(other._cached_node_arrs);
+  other.clearMeshSupport();
+}
+
 int MEDFileFieldRepresentationLeaves::getNumberOfArrays() const
 {
   return (int)_arrays.size();
@@ -594,20 +1129,41 @@ void MEDFileFieldRepresentationLeaves::feedSIL(const MEDCoupling::MEDFileMeshes
   //
   vtkIdType root3(sil->AddChild(root,edge));
   names.push_back(std::string("InfoOnGeoType"));
+  std::vector<std::string> gts(getGeoTypesRepr(ms,meshName));
+  for(std::vector<std::string>::const_iterator it2=gts.begin();it2!=gts.end();it2++)
+    {
+      sil->AddChild(root3,edge);
+      names.push_back(*it2);
+    }
+}
+
+std::vector<std::string> MEDFileFieldRepresentationLeaves::getGeoTypesRepr(const MEDCoupling::MEDFileMeshes *ms, const std::string& meshName) const
+{
+  std::vector<std::string> ret;
   const MEDCoupling::MEDFileMesh *m(0);
   if(ms)
     m=ms->getMeshWithName(meshName);
   const MEDCoupling::MEDFileFastCellSupportComparator *fsp(_fsp);
   if(!fsp || fsp->getNumberOfTS()==0)
-    return ;
+    return ret;
   std::vector< INTERP_KERNEL::NormalizedCellType > gts(fsp->getGeoTypesAt(0,m));
   for(std::vector< INTERP_KERNEL::NormalizedCellType >::const_iterator it2=gts.begin();it2!=gts.end();it2++)
     {
       const INTERP_KERNEL::CellModel& cm(INTERP_KERNEL::CellModel::GetCellModel(*it2));
       std::string cmStr(cm.getRepr()); cmStr=cmStr.substr(5);//skip "NORM_"
-      sil->AddChild(root3,edge);
-      names.push_back(cmStr);
+      ret.push_back(cmStr);
+    }
+  return ret;
+}
+
+void MEDFileFieldRepresentationLeaves::fillIndex(const MEDCoupling::MEDFileMeshes *ms, const std::string& meshName, MEDFileFieldRepresentationIndex::Leaf& leaf) const
+{
+  for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
+    {
+      leaf._arr_names.push_back((*it).getZeShortName());
+      leaf._arr_is_field_mesh.push_back(MEDFileFieldRepresentationTree::IsFieldMeshRegardingInfo((*it)->getInfo()));
     }
+  leaf._geo_types=getGeoTypesRepr(ms,meshName);
 }
 
 bool MEDFileFieldRepresentationLeaves::containId(int id) const
@@ -629,12 +1185,44 @@ bool MEDFileFieldRepresentationLeaves::containZeName(const char *name, int& id)
   return false;
 }
 
+void MEDFileFieldRepresentationLeaves::fillLookupIndex(std::unordered_map<std::string,int>& idPerName, std::vector<const MEDFileFieldRepresentationLeavesArrays *>& leafArrPerId) const
+{
+  for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
+    {
+      int id((*it).getId());
+      if(id<0 || id>=(int)leafArrPerId.size())
+        throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeaves::fillLookupIndex : ids are expected to be assigned before !");
+      idPerName[(*it).getZeName()]=id;
+      leafArrPerId[id]=&(*it);
+    }
+}
+
 void MEDFileFieldRepresentationLeaves::dumpState(std::map<std::string,bool>& status) const
 {
   for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
     status[(*it).getZeName()]=(*it).getStatus();
 }
 
+/*!
+ * Same than dumpState but the key is made of the mesh name, the field name and the discretization, which do not depend on the position of \a this in the tree.
+ */
+void MEDFileFieldRepresentationLeaves::dumpStatePerField(std::map<std::string,bool>& status) const
+{
+  std::string meshName(getMeshName());
+  for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
+    status[meshName+"/"+(*it).getZeShortName()]=(*it).getStatus();
+}
+
+/*!
+ * Fills \a idPerField with the ids of the arrays of \a this, keyed as in dumpStatePerField.
+ */
+void MEDFileFieldRepresentationLeaves::fillIdPerField(std::map<std::string,int>& idPerField) const
+{
+  std::string meshName(getMeshName());
+  for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
+    idPerField[meshName+"/"+(*it).getZeShortName()]=(*it).getId();
+}
+
 bool MEDFileFieldRepresentationLeaves::isActivated() const
 {
   for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
@@ -643,6 +1231,15 @@ bool MEDFileFieldRepresentationLeaves::isActivated() const
   return false;
 }
 
+std::vector<int> MEDFileFieldRepresentationLeaves::getActivatedIds() const
+{
+  std::vector<int> ret;
+  for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
+    if((*it).getStatus())
+      ret.push_back((*it).getId());
+  return ret;
+}
+
 void MEDFileFieldRepresentationLeaves::printMySelf(std::ostream& os) const
 {
   for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it0=_arrays.begin();it0!=_arrays.end();it0++)
@@ -662,6 +1259,12 @@ void MEDFileFieldRepresentationLeaves::activateAllArrays() const
     (*it).setStatus(true);
 }
 
+void MEDFileFieldRepresentationLeaves::deactivateAllArrays() const
+{
+  for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
+    (*it).setStatus(false);
+}
+
 const MEDFileFieldRepresentationLeavesArrays& MEDFileFieldRepresentationLeaves::getLeafArr(int id) const
 {
   for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
@@ -713,20 +1316,57 @@ std::string MEDFileFieldRepresentationLeaves::getHumanReadableOverviewOfTS() con
   return oss.str();
 }
 
-void MEDFileFieldRepresentationLeaves::appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshes *meshes, vtkDataSet *ds, ExportedTinyInfo *internalInfo) const
+void MEDFileFieldRepresentationLeaves::appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, vtkDataSet *ds, ExportedTinyInfo *internalInfo, int nbOfThreads, bool singlePrecision, MEDReaderTimings *timings) const
 {
   if(_arrays.size()<1)
     throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeaves::appendFields : internal error !");
-  MCAuto<MEDFileMeshStruct> mst(MEDFileMeshStruct::New(meshes->getMeshWithName(_arrays[0]->getMeshName().c_str())));
+  std::vector<const MEDFileFieldRepresentationLeavesArrays *> arrs;
   for(std::vector<MEDFileFieldRepresentationLeavesArrays>::const_iterator it=_arrays.begin();it!=_arrays.end();it++)
     if((*it).getStatus())
-      {
-        (*it).appendFields(tr,globs,mml,mst,ds,internalInfo);
-        (*it).appendELGAIfAny(ds);
-      }
+      arrs.push_back(&(*it));
+  if(nbOfThreads<=1)
+    {
+      for(std::vector<const MEDFileFieldRepresentationLeavesArrays *>::const_iterator it=arrs.begin();it!=arrs.end();it++)
+        {
+          tr->checkNotInterrupted();
+          (*it)->appendFields(tr,globs,mml,mst,ds,_elno_cache,internalInfo,singlePrecision,timings);
+          (*it)->appendELGAIfAny(ds);
+        }
+      return ;
+    }
+  // read and conversion of all (array,time step) are dispatched over threads. Attachment to ds (not thread safe) is done afterwards in the original order.
+  std::vector< std::vector<FieldArrayToAttach> > items(arrs.size());
+  std::vector< std::pair<std::size_t,std::size_t> > tasks;
+  for(std::size_t i=0;i<arrs.size();i++)
+    {
+      arrs[i]->prepareFields(tr,items[i],singlePrecision);
+      for(std::size_t j=0;j<items[i].size();j++)
+        tasks.push_back(std::pair<std::size_t,std::size_t>(i,j));
+    }
+  ExecuteConcurrently(nbOfThreads,tasks.size(),[&](std::size_t taskId)
+    {
+      tr->checkNotInterrupted();
+      const std::pair<std::size_t,std::size_t>& task(tasks[taskId]);
+      arrs[task.first]->loadField(globs,mml,mst,items[task.first][task.second],timings);
+    });
+  // ELGA offsets are dispatched by array. The information exported is gathered afterwards in the order of the arrays.
+  std::vector<ExportedTinyInfo> infos(arrs.size());
+  ExecuteConcurrently(nbOfThreads,arrs.size(),[&](std::size_t i)
+    {
+      for(std::vector<FieldArrayToAttach>::const_iterator it=items[i].begin();it!=items[i].end();it++)
+        arrs[i]->computeOffsets(*it,globs,ds,internalInfo?&infos[i]:0,timings);
+    });
+  for(std::size_t i=0;i<arrs.size();i++)
+    {
+      if(internalInfo)
+        internalInfo->append(infos[i]);
+      for(std::vector<FieldArrayToAttach>::const_iterator it=items[i].begin();it!=items[i].end();it++)
+        arrs[i]->attachField(*it,ds,_elno_cache);
+      arrs[i]->appendELGAIfAny(ds);
+    }
 }
 
-vtkUnstructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolationUnstructured(MEDUMeshMultiLev *mm) const
+vtkUnstructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolationUnstructured(MEDUMeshMultiLev *mm, bool singlePrecision) const
 {
   DataArrayDouble *coordsMC(0);
   DataArrayByte *typesMC(0);
@@ -763,9 +1403,7 @@ vtkUnstructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInt
   cellLocations->Delete();
   cells->Delete();
   vtkPoints *pts(vtkPoints::New());
-  vtkDoubleArray *pts2(vtkDoubleArray::New());
-  pts2->SetNumberOfComponents(3);
-  AssignDataPointerToVTK<double>(pts2,coordsSafe,statusOfCoords);
+  vtkDataArray *pts2(BuildVTKArrayOfCoords(coordsSafe,statusOfCoords,3,singlePrecision));
   pts->SetData(pts2);
   pts2->Delete();
   ret->SetPoints(pts);
@@ -774,50 +1412,52 @@ vtkUnstructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInt
   return ret;
 }
 
-vtkRectilinearGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolationCartesian(MEDCoupling::MEDCMeshMultiLev *mm) const
+/*!
+ * The axes are taken from \a coordsCache if another leaf on the same mesh already built them.
+ */
+vtkRectilinearGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolationCartesian(MEDCoupling::MEDCMeshMultiLev *mm, bool singlePrecision, const StructuredCoordsCache *coordsCache) const
 {
   bool isInternal;
   std::vector< DataArrayDouble * > arrs(mm->buildVTUArrays(isInternal));
-  vtkDoubleArray *vtkTmp(0);
   vtkRectilinearGrid *ret(vtkRectilinearGrid::New());
   std::size_t dim(arrs.size());
   if(dim<1 || dim>3)
     throw INTERP_KERNEL::Exception("buildVTKInstanceNoTimeInterpolationCartesian : dimension must be in [1,3] !");
   int sizePerAxe[3]={1,1,1};
-  sizePerAxe[0]=arrs[0]->getNbOfElems();
-  if(dim>=2)
-    sizePerAxe[1]=arrs[1]->getNbOfElems();
-  if(dim==3)
-    sizePerAxe[2]=arrs[2]->getNbOfElems();
-  ret->SetDimensions(sizePerAxe[0],sizePerAxe[1],sizePerAxe[2]);
-  vtkTmp=vtkDoubleArray::New();
-  vtkTmp->SetNumberOfComponents(1);
-  AssignDataPointerToVTK<double>(vtkTmp,arrs[0],isInternal);
-  ret->SetXCoordinates(vtkTmp);
-  vtkTmp->Delete();
-  arrs[0]->decrRef();
-  if(dim>=2)
+  std::vector<vtkIdType> nbOfTuples(dim);
+  for(std::size_t i=0;i<dim;i++)
     {
-      vtkTmp=vtkDoubleArray::New();
-      vtkTmp->SetNumberOfComponents(1);
-      AssignDataPointerToVTK<double>(vtkTmp,arrs[1],isInternal);
-      ret->SetYCoordinates(vtkTmp);
-      vtkTmp->Delete();
-      arrs[1]->decrRef();
+      sizePerAxe[i]=arrs[i]->getNbOfElems();
+      nbOfTuples[i]=sizePerAxe[i];
     }
-  if(dim==3)
+  ret->SetDimensions(sizePerAxe[0],sizePerAxe[1],sizePerAxe[2]);
+  std::vector<vtkDataArray *> axes;
+  if(coordsCache)
+    axes=coordsCache->retrieve(getMeshName(),singlePrecision,nbOfTuples);
+  if(axes.empty())
     {
-      vtkTmp=vtkDoubleArray::New();
-      vtkTmp->SetNumberOfComponents(1);
-      AssignDataPointerToVTK<double>(vtkTmp,arrs[2],isInternal);
-      ret->SetZCoordinates(vtkTmp);
-      vtkTmp->Delete();
-      arrs[2]->decrRef();
+      for(std::size_t i=0;i<dim;i++)
+        axes.push_back(BuildVTKArrayOfCoords(arrs[i],isInternal,1,singlePrecision));
+      if(coordsCache)
+        coordsCache->store(getMeshName(),singlePrecision,axes);
     }
+  for(std::size_t i=0;i<dim;i++)
+    arrs[i]->decrRef();
+  ret->SetXCoordinates(axes[0]);
+  if(dim>=2)
+    ret->SetYCoordinates(axes[1]);
+  if(dim==3)
+    ret->SetZCoordinates(axes[2]);
+  for(std::vector<vtkDataArray *>::const_iterator it=axes.begin();it!=axes.end();it++)
+    (*it)->Delete();
   return ret;
 }
 
-vtkStructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolationCurveLinear(MEDCoupling::MEDCurveLinearMeshMultiLev *mm) const
+/*!
+ * 3 components coordinates are given to VTK without copy. Coordinates with less components are padded with 0. once for all the leaves on
+ * the mesh thanks to \a coordsCache.
+ */
+vtkStructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolationCurveLinear(MEDCoupling::MEDCurveLinearMeshMultiLev *mm, bool singlePrecision, const StructuredCoordsCache *coordsCache) const
 {
   int meshStr[3]={1,1,1};
   DataArrayDouble *coords(0);
@@ -834,14 +1474,23 @@ vtkStructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInter
     meshStr[2]=nodeStrct[2];
   vtkStructuredGrid *ret(vtkStructuredGrid::New());
   ret->SetDimensions(meshStr[0],meshStr[1],meshStr[2]);
-  vtkDoubleArray *da(vtkDoubleArray::New());
-  da->SetNumberOfComponents(3);
-  if(coords->getNumberOfComponents()==3)
-    AssignDataPointerToVTK<double>(da,coords,isInternal);//if isIntenal==True VTK has not the ownership of double * because MEDLoader main struct has it !
+  vtkDataArray *da(0);
+  std::vector<vtkDataArray *> pts;
+  if(coordsCache)
+    pts=coordsCache->retrieve(getMeshName(),singlePrecision,std::vector<vtkIdType>(1,coords->getNumberOfTuples()));
+  if(!pts.empty())
+    da=pts[0];
   else
     {
-      MCAuto<DataArrayDouble> coords2(coords->changeNbOfComponents(3,0.));
-      AssignDataPointerToVTK<double>(da,coords2,false);//let VTK deal with double *
+      if(coords->getNumberOfComponents()==3)
+        da=BuildVTKArrayOfCoords(coords,isInternal,3,singlePrecision);//if isIntenal==True VTK has not the ownership of double * because MEDLoader main struct has it !
+      else
+        {
+          MCAuto<DataArrayDouble> coords2(coords->changeNbOfComponents(3,0.));
+          da=BuildVTKArrayOfCoords(coords2,false,3,singlePrecision);//let VTK deal with double *
+        }
+      if(coordsCache)
+        coordsCache->store(getMeshName(),singlePrecision,std::vector<vtkDataArray *>(1,da));
     }
   coords->decrRef();
   vtkPoints *points=vtkPoints::New();
@@ -852,43 +1501,37 @@ vtkStructuredGrid *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInter
   return ret;
 }
  
-vtkDataSet *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolation(const MEDTimeReq *tr, const MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDFileMeshes *meshes, ExportedTinyInfo *internalInfo) const
+/*!
+ * Builds the support shared by all the time steps (the support is assumed not to change over time) : topology, family, number and global node id arrays.
+ * Nothing is done if it has already been built.
+ */
+void MEDFileFieldRepresentationLeaves::buildMeshSupportIfNeeded(const MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDFileMeshes *meshes, bool singlePrecision, MEDReaderTimings *timings, const StructuredCoordsCache *coordsCache) const
 {
-  vtkDataSet *ret(0);
-  //_fsp->isDataSetSupportEqualToThePreviousOne(i,globs);
+  if(_cached_ds && _cached_single_precision==singlePrecision)
+    return ;
+  MEDReaderStageTimer timer(timings,MEDReaderTimings::BUILD_VTU_ARRAYS);
+  clearMeshSupport();
   MCAuto<MEDMeshMultiLev> mml(_fsp->buildFromScratchDataSetSupport(0,globs));//0=timestep Id. Make the hypothesis that support does not change 
   MCAuto<MEDMeshMultiLev> mml2(mml->prepare());
   MEDMeshMultiLev *ptMML2(mml2);
-  if(!_cached_ds)
+  MEDUMeshMultiLev *ptUMML2(dynamic_cast<MEDUMeshMultiLev *>(ptMML2));
+  MEDCMeshMultiLev *ptCMML2(dynamic_cast<MEDCMeshMultiLev *>(ptMML2));
+  MEDCurveLinearMeshMultiLev *ptCLMML2(dynamic_cast<MEDCurveLinearMeshMultiLev *>(ptMML2));
+  vtkDataSet *ds(0);
+  if(ptUMML2)
     {
-      MEDUMeshMultiLev *ptUMML2(dynamic_cast<MEDUMeshMultiLev *>(ptMML2));
-      MEDCMeshMultiLev *ptCMML2(dynamic_cast<MEDCMeshMultiLev *>(ptMML2));
-      MEDCurveLinearMeshMultiLev *ptCLMML2(dynamic_cast<MEDCurveLinearMeshMultiLev *>(ptMML2));
-      
-      if(ptUMML2)
-        {
-          ret=buildVTKInstanceNoTimeInterpolationUnstructured(ptUMML2);
-        }
-      else if(ptCMML2)
-        {
-          ret=buildVTKInstanceNoTimeInterpolationCartesian(ptCMML2);
-        }
-      else if(ptCLMML2)
-        {
-          ret=buildVTKInstanceNoTimeInterpolationCurveLinear(ptCLMML2);
-        }
-      else
-        throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolation : unrecognized mesh ! Supported for the moment unstructured, cartesian, curvelinear !");
-      _cached_ds=ret->NewInstance();
-      _cached_ds->ShallowCopy(ret);
+      ds=buildVTKInstanceNoTimeInterpolationUnstructured(ptUMML2,singlePrecision);
     }
-  else
+  else if(ptCMML2)
     {
-      ret=_cached_ds->NewInstance();
-      ret->ShallowCopy(_cached_ds);
+      ds=buildVTKInstanceNoTimeInterpolationCartesian(ptCMML2,singlePrecision,coordsCache);
     }
-  //
-  appendFields(tr,globs,mml,meshes,ret,internalInfo);
+  else if(ptCLMML2)
+    {
+      ds=buildVTKInstanceNoTimeInterpolationCurveLinear(ptCLMML2,singlePrecision,coordsCache);
+    }
+  else
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolation : unrecognized mesh ! Supported for the moment unstructured, cartesian, curvelinear !");
   // The arrays links to mesh
   DataArrayIdType *famCells(0),*numCells(0);
   bool noCpyFamCells(false),noCpyNumCells(false);
@@ -899,19 +1542,17 @@ vtkDataSet *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolatio
       vtkTab->SetNumberOfComponents(1);
       vtkTab->SetName(MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_CELL_NAME);
       AssignDataPointerToVTK<mcIdType>(vtkTab,famCells,noCpyFamCells);
-      ret->GetCellData()->AddArray(vtkTab);
-      vtkTab->Delete();
+      vtkTab->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
+      _cached_cell_arrs.push_back(vtkTab);
       famCells->decrRef();
     }
   ptMML2->retrieveNumberIdsOnCells(numCells,noCpyNumCells);
   if(numCells)
     {
-      vtkMCIdTypeArray *vtkTab(vtkMCIdTypeArray::New());
-      vtkTab->SetNumberOfComponents(1);
+      vtkDataArray *vtkTab(BuildVTKArrayOfIds(numCells,noCpyNumCells,singlePrecision));
       vtkTab->SetName(MEDFileFieldRepresentationLeavesArrays::NUM_ID_CELL_NAME);
-      AssignDataPointerToVTK<mcIdType>(vtkTab,numCells,noCpyNumCells);
-      ret->GetCellData()->AddArray(vtkTab);
-      vtkTab->Delete();
+      vtkTab->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
+      _cached_cell_arrs.push_back(vtkTab);
       numCells->decrRef();
     }
   // The arrays links to mesh
@@ -924,19 +1565,17 @@ vtkDataSet *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolatio
       vtkTab->SetNumberOfComponents(1);
       vtkTab->SetName(MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME);
       AssignDataPointerToVTK<mcIdType>(vtkTab,famNodes,noCpyFamNodes);
-      ret->GetPointData()->AddArray(vtkTab);
-      vtkTab->Delete();
+      vtkTab->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
+      _cached_node_arrs.push_back(vtkTab);
       famNodes->decrRef();
     }
   ptMML2->retrieveNumberIdsOnNodes(numNodes,noCpyNumNodes);
   if(numNodes)
     {
-      vtkMCIdTypeArray *vtkTab(vtkMCIdTypeArray::New());
-      vtkTab->SetNumberOfComponents(1);
+      vtkDataArray *vtkTab(BuildVTKArrayOfIds(numNodes,noCpyNumNodes,singlePrecision));
       vtkTab->SetName(MEDFileFieldRepresentationLeavesArrays::NUM_ID_NODE_NAME);
-      AssignDataPointerToVTK<mcIdType>(vtkTab,numNodes,noCpyNumNodes);
-      ret->GetPointData()->AddArray(vtkTab);
-      vtkTab->Delete();
+      vtkTab->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
+      _cached_node_arrs.push_back(vtkTab);
       numNodes->decrRef();
     }
   // Global Node Ids if any ! (In // mode)
@@ -947,21 +1586,115 @@ vtkDataSet *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolatio
       vtkTab->SetNumberOfComponents(1);
       vtkTab->SetName(MEDFileFieldRepresentationLeavesArrays::GLOBAL_NODE_ID_NAME);
       AssignDataPointerToVTK<mcIdType>(vtkTab,gni,false);
-      ret->GetPointData()->AddArray(vtkTab);
-      vtkTab->Delete();
+      vtkTab->GetInformation()->Set(MEDUtilities::SHARED_MEMORY(),1);
+      _cached_node_arrs.push_back(vtkTab);
       gni->decrRef();
     }
+  _cached_mst=MEDFileMeshStruct::New(meshes->getMeshWithName(_arrays[0]->getMeshName().c_str()));
+  _cached_mml=mml; _cached_mml2=mml2;
+  timer.setNumberOfBytes(1024ULL*ds->GetActualMemorySize());
+  _cached_ds=ds;
+  _cached_single_precision=singlePrecision;
+}
+
+void MEDFileFieldRepresentationLeaves::appendMeshArrays(vtkDataSet *ds) const
+{
+  for(std::vector<vtkDataArray *>::const_iterator it=_cached_cell_arrs.begin();it!=_cached_cell_arrs.end();it++)
+    ds->GetCellData()->AddArray(*it);
+  for(std::vector<vtkDataArray *>::const_iterator it=_cached_node_arrs.begin();it!=_cached_node_arrs.end();it++)
+    ds->GetPointData()->AddArray(*it);
+}
+
+/*!
+ * Only the fields are built at each call. The support (topology and arrays linked to the mesh) is built once and shared by all the datasets returned.
+ */
+vtkDataSet *MEDFileFieldRepresentationLeaves::buildVTKInstanceNoTimeInterpolation(const MEDTimeReq *tr, const MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDFileMeshes *meshes, ExportedTinyInfo *internalInfo, int nbOfThreads, bool singlePrecision, MEDReaderTimings *timings, const StructuredCoordsCache *coordsCache) const
+{
+  buildMeshSupportIfNeeded(globs,meshes,singlePrecision,timings,coordsCache);
+  vtkSmartPointer<vtkDataSet> ret;
+  ret.TakeReference(_cached_ds->NewInstance());
+  ret->ShallowCopy(_cached_ds);
+  appendFields(tr,globs,_cached_mml,_cached_mst,ret,internalInfo,nbOfThreads,singlePrecision,timings);
+  appendMeshArrays(ret);
+  ret->Register(0);// ownership given to the caller
   return ret;
 }
 
 //////////////////////
 
-MEDFileFieldRepresentationTree::MEDFileFieldRepresentationTree()
+const double TimeIndex::EPS=1e-14;
+
+void TimeIndex::update(const std::vector<double>& ts) const
+{
+  if(ts==_ts)
+    return ;
+  _ts=ts;
+  _sorted.resize(_ts.size());
+  for(std::size_t i=0;i<_ts.size();i++)
+    _sorted[i]=std::pair<double,std::size_t>(_ts[i],i);
+  std::sort(_sorted.begin(),_sorted.end());
+}
+
+/*!
+ * Returns the position in the time steps of \a timeReq. The first position having a time closer than EPS of \a timeReq is returned.
+ * When there is no such time step, \a isExact is set to false and the position of the highest time step lower than \a timeReq is returned,
+ * or if none, the position of the lowest time step. Among equal time steps the lowest position is kept.
+ */
+std::size_t TimeIndex::find(double timeReq, bool& isExact) const
+{
+  if(_sorted.empty())
+    throw INTERP_KERNEL::Exception("TimeIndex::find : no time steps !");
+  typedef std::vector< std::pair<double,std::size_t> >::const_iterator Iter;
+  auto lessVal([](const std::pair<double,std::size_t>& elt, double val) { return elt.first<val; });
+  isExact=true;
+  if(_sorted.size()!=1)
+    {
+      std::size_t ret(_sorted.size());
+      for(Iter it=std::lower_bound(_sorted.begin(),_sorted.end(),timeReq-EPS,lessVal);it!=_sorted.end() && (*it).first<=timeReq+EPS;it++)
+        if(fabs((*it).first-timeReq)<EPS)
+          ret=std::min(ret,(*it).second);
+      if(ret!=_sorted.size())
+        return ret;
+    }
+  Iter it(std::lower_bound(_sorted.begin(),_sorted.end(),timeReq,lessVal));
+  if(it!=_sorted.end() && (*it).first==timeReq)
+    return (*it).second;
+  isExact=false;
+  if(it==_sorted.begin())
+    return (*it).second;
+  it--;
+  return (*std::lower_bound(_sorted.begin(),it,(*it).first,lessVal)).second;
+}
+
+//////////////////////
+
+MEDFileFieldRepresentationTree::MEDFileFieldRepresentationTree():_nb_of_threads(1),_lazy_mesh_loading(false),_weighted_partitioning(false),_single_precision(false),_generate_vectors(false),_structure_stamp(0)
 {
 }
 
+/*!
+ * The datasets already cached have been built with the previous precision, so they are dropped when the precision changes.
+ */
+void MEDFileFieldRepresentationTree::setSinglePrecision(bool singlePrecision)
+{
+  if(_single_precision==singlePrecision)
+    return ;
+  _single_precision=singlePrecision;
+  _cache.clear();
+}
+
+void MEDFileFieldRepresentationTree::setGenerateVectors(bool generateVectors)
+{
+  if(_generate_vectors==generateVectors)
+    return ;
+  _generate_vectors=generateVectors;
+  _cache.clear();
+}
+
 int MEDFileFieldRepresentationTree::getNumberOfLeavesArrays() const
 {
+  if(_index.isLoaded())
+    return _index.getNumberOfLeavesArrays();
   int ret(0);
   for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
     for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
@@ -1002,6 +1735,11 @@ void MEDFileFieldRepresentationTree::computeFullNameInLeaves() const
 
 void MEDFileFieldRepresentationTree::activateTheFirst() const
 {
+  if(_index.isLoaded())
+    {
+      _index.activateTheFirst();
+      return ;
+    }
   for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
     for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
       for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
@@ -1013,6 +1751,11 @@ void MEDFileFieldRepresentationTree::activateTheFirst() const
 
 void MEDFileFieldRepresentationTree::feedSIL(vtkMutableDirectedGraph* sil, vtkIdType root, vtkVariantArray *edge, std::vector<std::string>& names) const
 {
+  if(_index.isLoaded())
+    {
+      _index.feedSIL(sil,root,edge,names);
+      return ;
+    }
   std::size_t it0Cnt(0);
   for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++,it0Cnt++)
     {
@@ -1062,6 +1805,8 @@ void MEDFileFieldRepresentationTree::feedSIL(vtkMutableDirectedGraph* sil, vtkId
 
 std::string MEDFileFieldRepresentationTree::getActiveMeshName() const
 {
+  if(_index.isLoaded())
+    return _index.getActiveMeshName();
   int dummy0(0),dummy1(0),dummy2(0);
   const MEDFileFieldRepresentationLeaves& leaf(getTheSingleActivated(dummy0,dummy1,dummy2));
   return leaf.getMeshName();
@@ -1069,6 +1814,8 @@ std::string MEDFileFieldRepresentationTree::getActiveMeshName() const
 
 std::string MEDFileFieldRepresentationTree::feedSILForFamsAndGrps(vtkMutableDirectedGraph* sil, vtkIdType root, vtkVariantArray *edge, std::vector<std::string>& names) const
 {
+  if(_index.isLoaded())
+    return _index.feedSILForFamsAndGrps(sil,root,edge,names);
   int dummy0(0),dummy1(0),dummy2(0);
   const MEDFileFieldRepresentationLeaves& leaf(getTheSingleActivated(dummy0,dummy1,dummy2));
   std::string ret(leaf.getMeshName());
@@ -1115,46 +1862,50 @@ std::string MEDFileFieldRepresentationTree::feedSILForFamsAndGrps(vtkMutableDire
 
 const MEDFileFieldRepresentationLeavesArrays& MEDFileFieldRepresentationTree::getLeafArr(int id) const
 {
-  for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
-    for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
-      for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
-        if((*it2).containId(id))
-          return (*it2).getLeafArr(id);
+  if(id>=0 && id<(int)_leaf_arr_per_id.size() && _leaf_arr_per_id[id])
+    return *_leaf_arr_per_id[id];
   throw INTERP_KERNEL::Exception("Internal error in MEDFileFieldRepresentationTree::getLeafArr !");
 }
 
 std::string MEDFileFieldRepresentationTree::getNameOf(int id) const
 {
+  if(_index.isLoaded())
+    return _index.getNameOf(id);
   const MEDFileFieldRepresentationLeavesArrays& elt(getLeafArr(id));
   return elt.getZeName();
 }
 
 const char *MEDFileFieldRepresentationTree::getNameOfC(int id) const
 {
+  if(_index.isLoaded())
+    return _index.getNameOfC(id);
   const MEDFileFieldRepresentationLeavesArrays& elt(getLeafArr(id));
   return elt.getZeNameC();
 }
 
 bool MEDFileFieldRepresentationTree::getStatusOf(int id) const
 {
+  if(_index.isLoaded())
+    return _index.getStatusOf(id);
   const MEDFileFieldRepresentationLeavesArrays& elt(getLeafArr(id));
   return elt.getStatus();
 }
 
 int MEDFileFieldRepresentationTree::getIdHavingZeName(const char *name) const
 {
-  int ret(-1);
-  for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
-    for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
-      for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
-        if((*it2).containZeName(name,ret))
-          return ret;
+  if(_index.isLoaded())
+    return _index.getIdHavingZeName(name);
+  std::unordered_map<std::string,int>::const_iterator it(_id_per_name.find(name));
+  if(it!=_id_per_name.end())
+    return (*it).second;
   std::ostringstream msg; msg << "MEDFileFieldRepresentationTree::getIdHavingZeName : No such a name \"" << name << "\" !";
   throw INTERP_KERNEL::Exception(msg.str().c_str());
 }
 
 bool MEDFileFieldRepresentationTree::changeStatusOfAndUpdateToHaveCoherentVTKDataSet(int id, bool status) const
 {
+  if(_index.isLoaded())
+    return _index.changeStatusOf(id,status);
   const MEDFileFieldRepresentationLeavesArrays& elt(getLeafArr(id));
   bool ret(elt.setStatus(status));//to be implemented
   return ret;
@@ -1162,6 +1913,8 @@ bool MEDFileFieldRepresentationTree::changeStatusOfAndUpdateToHaveCoherentVTKDat
 
 int MEDFileFieldRepresentationTree::getMaxNumberOfTimeSteps() const
 {
+  if(_index.isLoaded())
+    return _index.getMaxNumberOfTimeSteps();
   int ret(0);
   for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
     for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
@@ -1175,6 +1928,8 @@ int MEDFileFieldRepresentationTree::getMaxNumberOfTimeSteps() const
  */
 void MEDFileFieldRepresentationTree::loadInMemory(MEDCoupling::MEDFileFields *fields, MEDCoupling::MEDFileMeshes *meshes)
 {
+  MEDReaderStageTimer timer(&_timings,MEDReaderTimings::LOAD_IN_MEMORY);
+  _structured_coords.clear();
   _fields=fields; _ms=meshes;
   if(_fields.isNotNull())
     _fields->incrRef();
@@ -1288,6 +2043,22 @@ void MEDFileFieldRepresentationTree::loadInMemory(MEDCoupling::MEDFileFields *fi
   this->removeEmptyLeaves();
   this->assignIds();
   this->computeFullNameInLeaves();
+  this->buildLookupIndex();
+  this->_structure_stamp++;
+}
+
+/*!
+ * Fills the tables used by getIdHavingZeName and getLeafArr. To be called each time the ids or the names of the leaves change.
+ */
+void MEDFileFieldRepresentationTree::buildLookupIndex()
+{
+  _id_per_name.clear();
+  _leaf_arr_per_id.clear();
+  _leaf_arr_per_id.resize(getNumberOfLeavesArrays(),0);
+  for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
+    for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
+      for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+        (*it2).fillLookupIndex(_id_per_name,_leaf_arr_per_id);
 }
 
 void MEDFileFieldRepresentationTree::loadMainStructureOfFile(const char *fileName, int iPart, int nbOfParts)
@@ -1295,14 +2066,29 @@ void MEDFileFieldRepresentationTree::loadMainStructureOfFile(const char *fileNam
   MCAuto<MEDFileMeshes> ms;
   MCAuto<MEDFileFields> fields;
     {
-      if((iPart==-1 && nbOfParts==-1) || (iPart==0 && nbOfParts==1))
+      std::lock_guard<std::mutex> lock(GetHDF5Mutex());
+      MEDReaderStageTimer timer(&_timings,MEDReaderTimings::FILE_OPEN);
+      bool isSequential((iPart==-1 && nbOfParts==-1) || (iPart==0 && nbOfParts==1));
+      if(isSequential && _geo_types_to_load.empty())
         {
           MCAuto<MEDFileMeshSupports> msups(MEDFileMeshSupports::New(fileName));
           MCAuto<MEDFileStructureElements> mse(MEDFileStructureElements::New(fileName,msups));
-          ms=MEDFileMeshes::New(fileName);
+          _incomplete_meshes.clear();
+          if(_lazy_mesh_loading)
+            {
+              ms=LoadMeshesWithoutPerEntityArrays(fileName);
+              _incomplete_meshes=ms->getMeshesNames();
+            }
+          else
+            ms=MEDFileMeshes::New(fileName);
           fields=MEDFileFields::NewWithDynGT(fileName,mse,false);//false is important to not read the values
           if(ms->presenceOfStructureElements())
             {// pre traitement
+              if(!_incomplete_meshes.empty())
+                {// blowUpSE needs the whole meshes
+                  ms=MEDFileMeshes::New(fileName);
+                  _incomplete_meshes.clear();
+                }
               fields->loadArrays();
               fields->blowUpSE(ms,mse);
             }
@@ -1315,46 +2101,605 @@ void MEDFileFieldRepresentationTree::loadMainStructureOfFile(const char *fileNam
                 tmp2->forceComputationOfParts();
             }
         }
+      else if(isSequential)
+        {// read by parts as in parallel, with a single part restricted to the geometric types requested
+          ms=LoadPartOfMeshes(fileName,0,1,_geo_types_to_load);
+          ZipCoordsOfUMeshes(ms);
+          fields=MEDFileFields::LoadPartOf(fileName,false,ms);//false is important to not read the values
+          _incomplete_meshes.clear();
+        }
       else
         {
 #ifdef MEDREADER_USE_MPI
-          ms=ParaMEDFileMeshes::New(iPart,nbOfParts,fileName);
-          int nbMeshes(ms->getNumberOfMeshes());
-          for(int i=0;i<nbMeshes;i++)
-            {
-              MEDCoupling::MEDFileMesh *tmp(ms->getMeshAtPos(i));
-              MEDCoupling::MEDFileUMesh *tmp2(dynamic_cast<MEDCoupling::MEDFileUMesh *>(tmp));
-              if(tmp2)
-                MCAuto<DataArrayIdType> tmp3(tmp2->zipCoords());
-            }
+          if(_weighted_partitioning || !_geo_types_to_load.empty())
+            ms=LoadPartOfMeshes(fileName,iPart,nbOfParts,_geo_types_to_load);
+          else
+            ms=ParaMEDFileMeshes::New(iPart,nbOfParts,fileName);
+          ZipCoordsOfUMeshes(ms);
           fields=MEDFileFields::LoadPartOf(fileName,false,ms);//false is important to not read the values
+          _incomplete_meshes.clear();
 #else
           std::ostringstream oss; oss << "MEDFileFieldRepresentationTree::loadMainStructureOfFile : request for iPart/nbOfParts=" << iPart << "/" << nbOfParts << " whereas Plugin not compiled with MPI !";
           throw INTERP_KERNEL::Exception(oss.str().c_str());
 #endif
         }
+      timer.setNumberOfBytes(ms->getHeapMemorySize()+fields->getHeapMemorySize());
     }
+  _file_name=fileName;
+  _fields_signature=BuildFieldsSignature(fields);
+  loadInMemory(fields,ms);
+}
+
+/*!
+ * Re-reads the structure of the fields (not their values) of the file already loaded, to take into account the time steps and the fields
+ * appended to it since. Meshes are not read again : the ones in memory are kept, as well as the supports already built for the leaves
+ * found again and the status of the arrays, looked for by mesh, field and discretization. The datasets in cache are always dropped since their arrays may point to the values of
+ * the previous fields (no copy mode). Nothing is done if the fields did not change.
+ *
+ * \return false if the incremental reload is not possible (meshes added or removed, structure elements, structure loaded from an index).
+ *          In this case \a this is left unchanged and a full load is required.
+ */
+bool MEDFileFieldRepresentationTree::reloadFieldsStructure(int iPart, int nbOfParts)
+{
+  if(_index.isLoaded() || _data_structure.empty() || _file_name.empty() || _ms->presenceOfStructureElements())
+    return false;
+  MCAuto<MEDFileFields> fields;
+  {
+    std::lock_guard<std::mutex> lock(GetHDF5Mutex());
+    MEDReaderStageTimer timer(&_timings,MEDReaderTimings::FILE_OPEN);
+    std::vector<std::string> meshNamesOnDisk(GetMeshNames(_file_name)),meshNames(_ms->getMeshesNames());
+    std::sort(meshNamesOnDisk.begin(),meshNamesOnDisk.end()); std::sort(meshNames.begin(),meshNames.end());
+    if(meshNamesOnDisk!=meshNames)
+      return false;
+    bool isSequential((iPart==-1 && nbOfParts==-1) || (iPart==0 && nbOfParts==1));
+    if(isSequential && !_geo_types_to_load.empty())
+      fields=MEDFileFields::LoadPartOf(_file_name,false,_ms);//false is important to not read the values
+    else if(isSequential)
+      {
+        MCAuto<MEDFileMeshSupports> msups(MEDFileMeshSupports::New(_file_name));
+        MCAuto<MEDFileStructureElements> mse(MEDFileStructureElements::New(_file_name,msups));
+        fields=MEDFileFields::NewWithDynGT(_file_name,mse,false);//false is important to not read the values
+      }
+    else
+      {
+#ifdef MEDREADER_USE_MPI
+        fields=MEDFileFields::LoadPartOf(_file_name,false,_ms);//false is important to not read the values
+#else
+        std::ostringstream oss; oss << "MEDFileFieldRepresentationTree::reloadFieldsStructure : request for iPart/nbOfParts=" << iPart << "/" << nbOfParts << " whereas Plugin not compiled with MPI !";
+        throw INTERP_KERNEL::Exception(oss.str().c_str());
+#endif
+      }
+    timer.setNumberOfBytes(fields->getHeapMemorySize());
+  }
+  std::string signature(BuildFieldsSignature(fields));
+  if(signature==_fields_signature)
+    return true;
+  // the old structure is kept alive until its supports have been given to the new one
+  std::map<std::string,bool> status(dumpStatePerField());
+  std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > > oldDataStructure;
+  oldDataStructure.swap(_data_structure);
+  MCAuto<MEDFileFields> oldFields(_fields);
+  MCAuto<MEDFileMeshes> ms(_ms);
+  _fields=0; _ms=0;
   loadInMemory(fields,ms);
+  _fields_signature=signature;
+  // the support of a leaf is built from the first time step of its first array : a new leaf takes the support of the old leaf having the same one
+  std::map<std::string,const MEDFileFieldRepresentationLeaves *> oldLeafPerSupport;
+  for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=oldDataStructure.begin();it0!=oldDataStructure.end();it0++)
+    for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
+      for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+        if(!(*it2).empty())
+          oldLeafPerSupport[(*it2).getSupportKey()]=&(*it2);
+  for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
+    for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
+      for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+        {
+          if((*it2).empty())
+            continue;
+          std::map<std::string,const MEDFileFieldRepresentationLeaves *>::const_iterator itOld(oldLeafPerSupport.find((*it2).getSupportKey()));
+          if(itOld!=oldLeafPerSupport.end())
+            (*it2).takeMeshSupportFrom(*(*itOld).second);
+        }
+  // with no copy, the arrays of the cached datasets point to the values held by oldFields which is released on return
+  _cache.clear();
+  // the arrays are found again by mesh, field and discretization, even if appended time steps moved them to another time series
+  std::map<std::string,int> idPerField;
+  for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
+    for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
+      for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+        (*it2).fillIdPerField(idPerField);
+  for(std::map<std::string,bool>::const_iterator it=status.begin();it!=status.end();it++)
+    {
+      std::map<std::string,int>::const_iterator itId(idPerField.find((*it).first));
+      if(itId!=idPerField.end())
+        changeStatusOfAndUpdateToHaveCoherentVTKDataSet((*itId).second,(*it).second);
+    }
+  try
+    {
+      int lev0(0),lev1(0),lev2(0);
+      getTheSingleActivated(lev0,lev1,lev2);
+    }
+  catch(INTERP_KERNEL::Exception&)
+    {// the activated arrays are now in several leaves : only the first of these leaves is kept. If none, the first leaf is activated.
+      bool found(false);
+      for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
+        for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
+          for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+            {
+              if(!(*it2).isActivated())
+                continue;
+              if(found)
+                (*it2).deactivateAllArrays();
+              found=true;
+            }
+      if(!found)
+        activateTheFirst();
+    }
+  return true;
+}
+
+/*!
+ * Identifies the fields and their time steps. Two reads of a file giving the same signature have the same structure.
+ */
+std::string MEDFileFieldRepresentationTree::BuildFieldsSignature(const MEDCoupling::MEDFileFields *fields)
+{
+  std::ostringstream oss;
+  int nbOfFields(fields->getNumberOfFields());
+  for(int i=0;i<nbOfFields;i++)
+    {
+      MCAuto<MEDFileAnyTypeFieldMultiTS> fmts(fields->getFieldAtPos(i));
+      std::string name(fmts->getName()),meshName(fmts->getMeshName());
+      oss << name.size() << ":" << name << meshName.size() << ":" << meshName << "(";
+      std::vector< std::pair<int,int> > its(fmts->getIterations());
+      for(std::vector< std::pair<int,int> >::const_iterator it=its.begin();it!=its.end();it++)
+        oss << (*it).first << "," << (*it).second << ";";
+      oss << ")";
+    }
+  return oss.str();
+}
+
+/*!
+ * Reads with a selector skipping the family, numbering and name arrays of cells and nodes. Coordinates and connectivity
+ * are still read because the split of the fields per common support relies on them. The skipped arrays are read by
+ * completeActivatedMeshIfNeeded.
+ */
+MEDCoupling::MEDFileMeshes *MEDFileFieldRepresentationTree::LoadMeshesWithoutPerEntityArrays(const char *fileName)
+{
+  MEDFileMeshReadSelector mrs;
+  mrs.setCellFamilyFieldReading(false); mrs.setNodeFamilyFieldReading(false);
+  mrs.setCellNameFieldReading(false); mrs.setNodeNameFieldReading(false);
+  mrs.setCellNumFieldReading(false); mrs.setNodeNumFieldReading(false);
+  MCAuto<MEDFileMeshes> ret(MEDFileMeshes::New());
+  std::vector<std::string> meshNames(GetMeshNames(fileName));
+  for(std::vector<std::string>::const_iterator it=meshNames.begin();it!=meshNames.end();it++)
+    {
+      MCAuto<MEDFileMesh> mesh(MEDFileMesh::New(fileName,*it,-1,-1,&mrs));
+      ret->pushMesh(mesh);
+    }
+  return ret.retn();
+}
+
+/*!
+ * Reads the part \a iPart over \a nbOfParts of the unstructured meshes of the file. Like ParaMEDFileMeshes each geometric type is sliced
+ * among the ranks, but the remainders are given to the least loaded ranks instead of the last one. The load of a cell is its number of nodes
+ * plus the largest number of Gauss points per cell defined on its geometric type in the file.
+ *
+ * \param [in] geoTypes - if not empty, only the cells of these types are read. Meshes having none of them, and meshes that are not
+ *              unstructured, are read entirely.
+ */
+MEDCoupling::MEDFileMeshes *MEDFileFieldRepresentationTree::LoadPartOfMeshes(const char *fileName, int iPart, int nbOfParts, const std::vector<INTERP_KERNEL::NormalizedCellType>& geoTypes)
+{
+  std::map<INTERP_KERNEL::NormalizedCellType,int> nbOfGaussPtsPerType;
+  {// only the localizations are read, not the structure of the fields
+    MEDFileUtilities::AutoFid fid(OpenMEDFileForRead(fileName));
+    med_int nbOfLocs(MEDnLocalization(fid));
+    for(med_int i=0;i<nbOfLocs;i++)
+      {
+        try
+          {
+            MCAuto<MEDFileFieldLoc> loc(MEDFileFieldLoc::New(fid,(int)i,0));
+            int& nbOfPts(nbOfGaussPtsPerType[loc->getGeoType()]);
+            nbOfPts=std::max(nbOfPts,loc->getNbOfGaussPtPerCell());
+          }
+        catch(INTERP_KERNEL::Exception&)
+          {// localization on a structure element : it does not weight the cells of the meshes
+          }
+      }
+  }
+  MCAuto<MEDFileMeshes> ret(MEDFileMeshes::New());
+  std::vector<std::string> meshNames(GetMeshNames(fileName));
+  for(std::vector<std::string>::const_iterator it=meshNames.begin();it!=meshNames.end();it++)
+    {
+      int meshDim,spaceDim;
+      mcIdType nbOfNodes;
+      std::vector< std::vector< std::pair<INTERP_KERNEL::NormalizedCellType,mcIdType> > > infos;
+      try
+        {
+          infos=GetUMeshGlobalInfo(fileName,*it,meshDim,spaceDim,nbOfNodes);
+        }
+      catch(INTERP_KERNEL::Exception&)
+        {
+          if(geoTypes.empty())
+            throw;
+        }
+      std::vector< std::pair<INTERP_KERNEL::NormalizedCellType,mcIdType> > nbOfCellsPerType;
+      for(std::vector< std::vector< std::pair<INTERP_KERNEL::NormalizedCellType,mcIdType> > >::const_iterator it2=infos.begin();it2!=infos.end();it2++)
+        for(std::vector< std::pair<INTERP_KERNEL::NormalizedCellType,mcIdType> >::const_iterator it3=(*it2).begin();it3!=(*it2).end();it3++)
+          if(geoTypes.empty() || std::find(geoTypes.begin(),geoTypes.end(),(*it3).first)!=geoTypes.end())
+            nbOfCellsPerType.push_back(*it3);
+      if(nbOfCellsPerType.empty() && !geoTypes.empty())
+        {
+          MCAuto<MEDFileMesh> mesh(MEDFileMesh::New(fileName,*it));
+          ret->pushMesh(mesh);
+          continue;
+        }
+      std::vector<INTERP_KERNEL::NormalizedCellType> types;
+      for(std::vector< std::pair<INTERP_KERNEL::NormalizedCellType,mcIdType> >::const_iterator it2=nbOfCellsPerType.begin();it2!=nbOfCellsPerType.end();it2++)
+        types.push_back((*it2).first);
+      std::vector<mcIdType> slices(ComputeWeightedSlices(nbOfCellsPerType,nbOfGaussPtsPerType,iPart,nbOfParts));
+      MCAuto<MEDFileUMesh> mesh(MEDFileUMesh::LoadPartOf(fileName,*it,types,slices));
+      ret->pushMesh(mesh);
+    }
+  return ret.retn();
+}
+
+/*!
+ * Removes the nodes not used by the cells of the unstructured meshes of \a ms, read by parts.
+ */
+void MEDFileFieldRepresentationTree::ZipCoordsOfUMeshes(MEDCoupling::MEDFileMeshes *ms)
+{
+  int nbMeshes(ms->getNumberOfMeshes());
+  for(int i=0;i<nbMeshes;i++)
+    {
+      MEDCoupling::MEDFileMesh *tmp(ms->getMeshAtPos(i));
+      MEDCoupling::MEDFileUMesh *tmp2(dynamic_cast<MEDCoupling::MEDFileUMesh *>(tmp));
+      if(tmp2)
+        MCAuto<DataArrayIdType> tmp3(tmp2->zipCoords());
+    }
+}
+
+/*!
+ * \param [in] geoTypes - comma or space separated names of geometric types, with or without the NORM_ prefix (for example "QUAD4,NORM_TRI3").
+ * \throw If a name is not the one of a geometric type.
+ */
+std::vector<INTERP_KERNEL::NormalizedCellType> MEDFileFieldRepresentationTree::ParseGeoTypes(const std::string& geoTypes)
+{
+  std::map<std::string,INTERP_KERNEL::NormalizedCellType> typePerName;
+  for(int i=0;i<(int)INTERP_KERNEL::NORM_MAXTYPE;i++)
+    {
+      INTERP_KERNEL::NormalizedCellType ct((INTERP_KERNEL::NormalizedCellType)i);
+      try
+        {
+          std::string repr(INTERP_KERNEL::CellModel::GetCellModel(ct).getRepr());
+          typePerName[repr]=ct;
+          if(repr.find("NORM_")==0)
+            typePerName[repr.substr(5)]=ct;
+        }
+      catch(INTERP_KERNEL::Exception&)
+        {// hole in the enum
+        }
+    }
+  std::vector<INTERP_KERNEL::NormalizedCellType> ret;
+  std::string tmp(geoTypes);
+  std::replace(tmp.begin(),tmp.end(),',',' ');
+  std::istringstream iss(tmp);
+  std::string name;
+  while(iss >> name)
+    {
+      std::map<std::string,INTERP_KERNEL::NormalizedCellType>::const_iterator it(typePerName.find(name));
+      if(it==typePerName.end())
+        {
+          std::ostringstream oss; oss << "MEDFileFieldRepresentationTree::ParseGeoTypes : \"" << name << "\" is not a geometric type !";
+          throw INTERP_KERNEL::Exception(oss.str().c_str());
+        }
+      if(std::find(ret.begin(),ret.end(),(*it).second)==ret.end())
+        ret.push_back((*it).second);
+    }
+  return ret;
+}
+
+/*!
+ * Computes the slices (start,stop,step) of each geometric type of \a nbOfCellsPerType given to the rank \a iPart over \a nbOfParts.
+ * Types are dealt by decreasing cost. Each rank receives the same number of cells of a type, and the remaining cells are given one
+ * by one to the ranks having the lowest load so far. Hence the number of cells of a type differs by at most one between two ranks.
+ *
+ * The number of nodes of the cells of a dynamic type is only known once the cells are read : the weights WEIGHT_OF_POLYHEDRON, WEIGHT_OF_QPOLYGON
+ * and WEIGHT_OF_POLYGON are estimations of it.
+ *
+ * \return a vector of size 3*nbOfCellsPerType.size() in the order of \a nbOfCellsPerType.
+ */
+std::vector<mcIdType> MEDFileFieldRepresentationTree::ComputeWeightedSlices(const std::vector< std::pair<INTERP_KERNEL::NormalizedCellType,mcIdType> >& nbOfCellsPerType,
+                                                                             const std::map<INTERP_KERNEL::NormalizedCellType,int>& nbOfGaussPtsPerType, int iPart, int nbOfParts)
+{
+  if(nbOfParts<1 || iPart<0 || iPart>=nbOfParts)
+    {
+      std::ostringstream oss; oss << "MEDFileFieldRepresentationTree::ComputeWeightedSlices : invalid iPart/nbOfParts=" << iPart << "/" << nbOfParts << " !";
+      throw INTERP_KERNEL::Exception(oss.str().c_str());
+    }
+  std::size_t nbOfTypes(nbOfCellsPerType.size());
+  // (-weight,position) to sort by decreasing weight keeping the order of the file for equal weights
+  std::vector< std::pair<mcIdType,std::size_t> > order(nbOfTypes);
+  for(std::size_t i=0;i<nbOfTypes;i++)
+    {
+      INTERP_KERNEL::NormalizedCellType ct(nbOfCellsPerType[i].first);
+      const INTERP_KERNEL::CellModel& cm(INTERP_KERNEL::CellModel::GetCellModel(ct));
+      mcIdType weight(cm.isDynamic()?(cm.getDimension()==3?WEIGHT_OF_POLYHEDRON:(cm.isQuadratic()?WEIGHT_OF_QPOLYGON:WEIGHT_OF_POLYGON)):(mcIdType)cm.getNumberOfNodes());
+      std::map<INTERP_KERNEL::NormalizedCellType,int>::const_iterator it(nbOfGaussPtsPerType.find(ct));
+      if(it!=nbOfGaussPtsPerType.end())
+        weight+=(*it).second;
+      order[i]=std::pair<mcIdType,std::size_t>(-weight,i);
+    }
+  std::sort(order.begin(),order.end());
+  std::vector<mcIdType> loads(nbOfParts,0),ret(3*nbOfTypes);
+  std::vector<mcIdType> nbOfCellsPerPart(nbOfParts);
+  for(std::vector< std::pair<mcIdType,std::size_t> >::const_iterator it=order.begin();it!=order.end();it++)
+    {
+      mcIdType weight(-(*it).first),nbOfCells(nbOfCellsPerType[(*it).second].second);
+      std::fill(nbOfCellsPerPart.begin(),nbOfCellsPerPart.end(),nbOfCells/nbOfParts);
+      mcIdType remainder(nbOfCells%nbOfParts);
+      if(remainder>0)
+        {
+          std::vector< std::pair<mcIdType,int> > loadPerPart(nbOfParts);
+          for(int i=0;i<nbOfParts;i++)
+            loadPerPart[i]=std::pair<mcIdType,int>(loads[i],i);
+          std::sort(loadPerPart.begin(),loadPerPart.end());
+          for(mcIdType i=0;i<remainder;i++)
+            nbOfCellsPerPart[loadPerPart[i].second]++;
+        }
+      mcIdType start(0);
+      for(int i=0;i<nbOfParts;i++)
+        {
+          if(i==iPart)
+            {
+              ret[3*(*it).second]=start; ret[3*(*it).second+1]=start+nbOfCellsPerPart[i]; ret[3*(*it).second+2]=1;
+            }
+          start+=nbOfCellsPerPart[i];
+          loads[i]+=weight*nbOfCellsPerPart[i];
+        }
+    }
+  return ret;
+}
+
+/*!
+ * Returns the MED file geometric type of \a ct. Static types are numbered 100*dimension+number of nodes in MED file.
+ */
+med_geometry_type MEDFileFieldRepresentationTree::ConvertToMEDGeoType(INTERP_KERNEL::NormalizedCellType ct)
+{
+  switch(ct)
+    {
+    case INTERP_KERNEL::NORM_POLYGON:
+      return MED_POLYGON;
+    case INTERP_KERNEL::NORM_QPOLYG:
+      return MED_POLYGON2;
+    case INTERP_KERNEL::NORM_POLYHED:
+      return MED_POLYHEDRON;
+    default:
+      {
+        const INTERP_KERNEL::CellModel& cm(INTERP_KERNEL::CellModel::GetCellModel(ct));
+        if(cm.isDynamic())
+          {
+            std::ostringstream oss; oss << "MEDFileFieldRepresentationTree::ConvertToMEDGeoType : no MED file type for " << cm.getRepr() << " !";
+            throw INTERP_KERNEL::Exception(oss.str().c_str());
+          }
+        return (med_geometry_type)(100*cm.getDimension()+cm.getNumberOfNodes());
+      }
+    }
+}
+
+/*!
+ * Reads in \a fid the family, numbering and name arrays of the entities of \a mesh at level \a meshDimRelToMaxExt and sets them to \a mesh.
+ * \param [in] entities - the MED file geometric types of the level, with their number of entities, in the order of \a mesh.
+ *              Families missing for a type are set to 0. Numbers and names are set only if present for all the types.
+ */
+void MEDFileFieldRepresentationTree::ReadPerEntityArrays(med_idt fid, MEDCoupling::MEDFileMesh *mesh, int meshDimRelToMaxExt, med_entity_type entity,
+                                                         const std::vector< std::pair<med_geometry_type,mcIdType> >& entities)
+{
+  std::string meshName(mesh->getName());
+  med_int dt(mesh->getIteration()),it(mesh->getOrder());
+  mcIdType nbOfEntities(0);
+  for(std::vector< std::pair<med_geometry_type,mcIdType> >::const_iterator it0=entities.begin();it0!=entities.end();it0++)
+    nbOfEntities+=(*it0).second;
+  MCAuto<DataArrayIdType> fam(DataArrayIdType::New()),num(DataArrayIdType::New());
+  MCAuto<DataArrayAsciiChar> names(DataArrayAsciiChar::New());
+  fam->alloc(nbOfEntities,1); fam->fillWithZero();
+  num->alloc(nbOfEntities,1);
+  names->alloc(nbOfEntities,MED_SNAME_SIZE);
+  bool hasFam(false),hasNum(true),hasNames(true);
+  mcIdType offset(0);
+  for(std::vector< std::pair<med_geometry_type,mcIdType> >::const_iterator it0=entities.begin();it0!=entities.end();offset+=(*it0).second,it0++)
+    {
+      med_geometry_type geoType((*it0).first);
+      mcIdType nb((*it0).second);
+      med_bool changement,transformation;
+      std::vector<med_int> tmp(nb);
+      if(nb>0 && MEDmeshnEntity(fid,meshName.c_str(),dt,it,entity,geoType,MED_FAMILY_NUMBER,MED_NODAL,&changement,&transformation)>0)
+        {
+          if(MEDmeshEntityFamilyNumberRd(fid,meshName.c_str(),dt,it,entity,geoType,&tmp[0])<0)
+            throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationTree::ReadPerEntityArrays : error while reading families !");
+          std::copy(tmp.begin(),tmp.end(),fam->getPointer()+offset);
+          hasFam=true;
+        }
+      if(hasNum && nb>0 && MEDmeshnEntity(fid,meshName.c_str(),dt,it,entity,geoType,MED_NUMBER,MED_NODAL,&changement,&transformation)>0)
+        {
+          if(MEDmeshEntityNumberRd(fid,meshName.c_str(),dt,it,entity,geoType,&tmp[0])<0)
+            throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationTree::ReadPerEntityArrays : error while reading numbers !");
+          std::copy(tmp.begin(),tmp.end(),num->getPointer()+offset);
+        }
+      else
+        hasNum=hasNum && nb==0;
+      if(hasNames && nb>0 && MEDmeshnEntity(fid,meshName.c_str(),dt,it,entity,geoType,MED_NAME,MED_NODAL,&changement,&transformation)>0)
+        {
+          std::vector<char> tmp2(nb*MED_SNAME_SIZE+1);
+          if(MEDmeshEntityNameRd(fid,meshName.c_str(),dt,it,entity,geoType,&tmp2[0])<0)
+            throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationTree::ReadPerEntityArrays : error while reading names !");
+          std::copy(tmp2.begin(),tmp2.begin()+nb*MED_SNAME_SIZE,names->getPointer()+offset*MED_SNAME_SIZE);
+        }
+      else
+        hasNames=hasNames && nb==0;
+    }
+  if(nbOfEntities==0)
+    return ;
+  if(hasFam)
+    mesh->setFamilyFieldArr(meshDimRelToMaxExt,fam);
+  if(hasNum)
+    mesh->setRenumFieldArr(meshDimRelToMaxExt,num);
+  if(hasNames)
+    mesh->setNameFieldAtLevel(meshDimRelToMaxExt,names);
+}
+
+/*!
+ * In lazy mesh loading mode, reads the family, numbering and name arrays of the mesh of the activated leaf if not already done.
+ * To be called once the status of the arrays is up to date and before buildVTKInstance.
+ */
+void MEDFileFieldRepresentationTree::completeActivatedMeshIfNeeded()
+{
+  if(_incomplete_meshes.empty())
+    return ;
+  std::string meshName(getActiveMeshName());
+  std::vector<std::string>::iterator pos(std::find(_incomplete_meshes.begin(),_incomplete_meshes.end(),meshName));
+  if(pos==_incomplete_meshes.end())
+    return ;
+  MEDFileMesh *mesh(_ms->getMeshWithName(meshName));
+  {// only the per-entity arrays are read : coordinates and connectivity are already in memory
+    std::lock_guard<std::mutex> lock(GetHDF5Mutex());
+    MEDFileUtilities::AutoFid fid(OpenMEDFileForRead(_file_name));
+    std::vector<int> levs(mesh->getNonEmptyLevels());
+    for(std::vector<int>::const_iterator it=levs.begin();it!=levs.end();it++)
+      {
+        std::vector<INTERP_KERNEL::NormalizedCellType> types(mesh->getGeoTypesAtLevel(*it));
+        std::vector< std::pair<med_geometry_type,mcIdType> > entities;
+        for(std::vector<INTERP_KERNEL::NormalizedCellType>::const_iterator it2=types.begin();it2!=types.end();it2++)
+          entities.push_back(std::pair<med_geometry_type,mcIdType>(ConvertToMEDGeoType(*it2),mesh->getNumberOfCellsWithType(*it2)));
+        ReadPerEntityArrays(fid,mesh,*it,MED_CELL,entities);
+      }
+    ReadPerEntityArrays(fid,mesh,1,MED_NODE,std::vector< std::pair<med_geometry_type,mcIdType> >(1,std::pair<med_geometry_type,mcIdType>(MED_NONE,mesh->getNumberOfNodes())));
+  }
+  _incomplete_meshes.erase(pos);
 }
 
+/*!
+ * Removes in place the empty leaves, then the meshes and the time series left without leaf. Leaves are copied only when they move,
+ * which is cheap as it is called by loadInMemory before any support is built. Meshes and time series are swapped, not copied.
+ */
 void MEDFileFieldRepresentationTree::removeEmptyLeaves()
 {
-  std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > > newSD;
+  std::size_t nb0(0);
+  for(std::size_t i0=0;i0<_data_structure.size();i0++)
+    {
+      std::vector< std::vector< MEDFileFieldRepresentationLeaves > >& sd0(_data_structure[i0]);
+      std::size_t nb1(0);
+      for(std::size_t i1=0;i1<sd0.size();i1++)
+        {
+          std::vector< MEDFileFieldRepresentationLeaves >& sd1(sd0[i1]);
+          std::size_t nb2(0);
+          for(std::size_t i2=0;i2<sd1.size();i2++)
+            if(!sd1[i2].empty())
+              {
+                if(nb2!=i2)
+                  sd1[nb2]=sd1[i2];
+                nb2++;
+              }
+          sd1.erase(sd1.begin()+nb2,sd1.end());
+          if(nb2>0)
+            {
+              if(nb1!=i1)
+                sd0[nb1].swap(sd1);
+              nb1++;
+            }
+        }
+      sd0.erase(sd0.begin()+nb1,sd0.end());
+      if(nb1>0)
+        {
+          if(nb0!=i0)
+            _data_structure[nb0].swap(sd0);
+          nb0++;
+        }
+    }
+  _data_structure.erase(_data_structure.begin()+nb0,_data_structure.end());
+}
+
+/*!
+ * Loads the structure of \a fileName from the index \a indexFileName if this index exists and is up to date regarding \a fileName.
+ * In this case \a this is able to answer to all requests on the structure but buildVTKInstance. loadMainStructureOfFileIfIndexOnly
+ * has to be called before the first buildVTKInstance.
+ *
+ * \return true if the index has been used.
+ */
+bool MEDFileFieldRepresentationTree::loadIndexOfFile(const char *fileName, const std::string& indexFileName)
+{
+  bool ret(_index.load(indexFileName,fileName));
+  if(ret)
+    _structure_stamp++;
+  return ret;
+}
+
+/*!
+ * Writes the index of the structure currently loaded in \a this. Nothing is done if \a this has been loaded from an index.
+ */
+void MEDFileFieldRepresentationTree::saveIndexOfFile(const char *fileName, const std::string& indexFileName) const
+{
+  if(_index.isLoaded() || _data_structure.empty())
+    return ;
+  MEDFileFieldRepresentationIndex idx;
+  fillIndex(idx);
+  idx.save(indexFileName,fileName);
+}
+
+/*!
+ * If \a this has been loaded from an index, the MED file is now really loaded. The status of the arrays is kept.
+ */
+void MEDFileFieldRepresentationTree::loadMainStructureOfFileIfIndexOnly(const char *fileName, int iPart, int nbOfParts)
+{
+  if(!_index.isLoaded())
+    return ;
+  std::map<std::string,bool> status(dumpState());
+  _index.clear();
+  loadMainStructureOfFile(fileName,iPart,nbOfParts);
+  for(std::map<std::string,bool>::const_iterator it=status.begin();it!=status.end();it++)
+    {
+      try
+        {
+          changeStatusOfAndUpdateToHaveCoherentVTKDataSet(getIdHavingZeName((*it).first.c_str()),(*it).second);
+        }
+      catch(INTERP_KERNEL::Exception&)
+        {// array not present anymore in the file.
+        }
+    }
+}
+
+void MEDFileFieldRepresentationTree::fillIndex(MEDFileFieldRepresentationIndex& idx) const
+{
+  idx.clear();
   for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
     {
-      std::vector< std::vector< MEDFileFieldRepresentationLeaves > > newSD0;
+      MEDFileFieldRepresentationIndex::TimeSeries ts;
+      ts._overview=(*it0)[0][0].getHumanReadableOverviewOfTS();
+      ts._dtits=(*it0)[0][0].getTimeStepsInCoarseMEDFileFormat(ts._ts);
       for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
         {
-          std::vector< MEDFileFieldRepresentationLeaves > newSD1;
-          for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
-            if(!(*it2).empty())
-              newSD1.push_back(*it2);
-          if(!newSD1.empty())
-            newSD0.push_back(newSD1);
+          std::string meshName((*it1)[0].getMeshName());
+          ts._mesh_names.push_back(meshName);
+          ts._leaves.push_back(std::vector<MEDFileFieldRepresentationIndex::Leaf>((*it1).size()));
+          std::size_t it2Cnt(0);
+          for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++,it2Cnt++)
+            (*it2).fillIndex(_ms,meshName,ts._leaves.back()[it2Cnt]);
         }
-      if(!newSD0.empty())
-        newSD.push_back(newSD0);
+      idx._time_series.push_back(ts);
+    }
+  for(int i=0;i<_ms->getNumberOfMeshes();i++)
+    {
+      const MEDFileMesh *m(_ms->getMeshAtPos(i));
+      MEDFileFieldRepresentationIndex::MeshInfo mi;
+      mi._name=m->getName();
+      mi._grps=m->getGroupsNames();
+      for(std::vector<std::string>::const_iterator it=mi._grps.begin();it!=mi._grps.end();it++)
+        mi._fams_on_grps.push_back(m->getFamiliesOnGroup((*it).c_str()));
+      mi._fams=m->getFamiliesNames();
+      for(std::vector<std::string>::const_iterator it=mi._fams.begin();it!=mi._fams.end();it++)
+        mi._fam_ids.push_back((int)m->getFamilyId((*it).c_str()));
+      idx._meshes.push_back(mi);
     }
+  idx.finalize();
 }
 
 bool MEDFileFieldRepresentationTree::IsFieldMeshRegardingInfo(const std::vector<std::string>& compInfos)
@@ -1364,79 +2709,106 @@ bool MEDFileFieldRepresentationTree::IsFieldMeshRegardingInfo(const std::vector<
   return compInfos[0]==COMPO_STR_TO_LOCATE_MESH_DA;
 }
 
+/*!
+ * HDF5 library is not assumed to be thread safe. All the reads performed by the trees of the process are serialized behind this mutex.
+ */
+std::mutex& MEDFileFieldRepresentationTree::GetHDF5Mutex()
+{
+  static std::mutex HDF5_MUTEX;
+  return HDF5_MUTEX;
+}
+
 std::string MEDFileFieldRepresentationTree::getDftMeshName() const
 {
+  if(_index.isLoaded())
+    return _index.getDftMeshName();
   return _data_structure[0][0][0].getMeshName();
 }
 
 std::vector<double> MEDFileFieldRepresentationTree::getTimeSteps(int& lev0, const TimeKeeper& tk) const
 {
+  if(_index.isLoaded())
+    {
+      std::vector<double> ts;
+      std::vector< std::pair<int,int> > dtits(_index.getTimeStepsOfActivated(lev0,ts));
+      return tk.getTimeStepsRegardingPolicy(dtits,ts);
+    }
   int lev1,lev2;
   const MEDFileFieldRepresentationLeaves& leaf(getTheSingleActivated(lev0,lev1,lev2));
   return leaf.getTimeSteps(tk);
 }
 
-vtkDataSet *MEDFileFieldRepresentationTree::buildVTKInstance(bool isStdOrMode, double timeReq, std::string& meshName, const TimeKeeper& tk, ExportedTinyInfo *internalInfo) const
+/*!
+ * \param [in] interrupt - optional flag polled between the arrays. When it turns to true the build is aborted by throwing an INTERP_KERNEL::Exception.
+ */
+vtkDataSet *MEDFileFieldRepresentationTree::buildVTKInstance(bool isStdOrMode, double timeReq, std::string& meshName, const TimeKeeper& tk, ExportedTinyInfo *internalInfo, const std::atomic<bool> *interrupt) const
 {
+  if(_index.isLoaded())
+    throw INTERP_KERNEL::Exception("MEDFileFieldRepresentationTree::buildVTKInstance : only the index of the file is loaded ! Invoke loadMainStructureOfFileIfIndexOnly before !");
   int lev0,lev1,lev2;
   const MEDFileFieldRepresentationLeaves& leaf(getTheSingleActivated(lev0,lev1,lev2));
   meshName=leaf.getMeshName();
   std::vector<double> ts(leaf.getTimeSteps(tk));
-  std::size_t zeTimeId(0);
-  if(ts.size()!=1)
-    {
-      std::vector<double> ts2(ts.size());
-      std::transform(ts.begin(),ts.end(),ts2.begin(),std::bind(std::plus<double>(),std::placeholders::_1,-timeReq));
-      std::transform(ts2.begin(),ts2.end(),ts2.begin(),[](double c) {return fabs(c);});
-      zeTimeId=std::distance(ts2.begin(),std::find_if(ts2.begin(),ts2.end(),std::bind(std::less<double>(),std::placeholders::_1,1e-14)));
-    }
-  //2nd chance
-  if(zeTimeId==ts.size())
-    zeTimeId=std::distance(ts.begin(),std::find(ts.begin(),ts.end(),timeReq));
-  if(zeTimeId==ts.size())
+  _time_index.update(ts);
+  bool isExact(true);
+  std::size_t zeTimeId(_time_index.find(timeReq,isExact));
+  if(!isExact)
     {//OK the time requested does not fit time series given to ParaView. It is typically the case if more than one MEDReader instance are created or TimeInspector in real time mode.
-      //In this case the default behaviour is taken. Keep the highest time step in this lower than timeReq.
-      int pos(-1);
-      double valAttachedToPos(-std::numeric_limits<double>::max());
-      for(std::size_t i=0;i<ts.size();i++)
-        {
-          if(ts[i]<timeReq)
-            {
-              if(ts[i]>valAttachedToPos)
-                {
-                  pos=(int)i;
-                  valAttachedToPos=ts[i];
-                }
-            }
-        }
-      if(pos==-1)
-        {// timeReq is lower than all time steps (ts). So let's keep the lowest time step greater than timeReq.
-          valAttachedToPos=std::numeric_limits<double>::max();
-          for(std::size_t i=0;i<ts.size();i++)
-            {
-              if(ts[i]<valAttachedToPos)
-                {
-                  pos=(int)i;
-                  valAttachedToPos=ts[i];
-                }
-            }
-        }
-      zeTimeId=pos;
+      //In this case the default behaviour is taken : the highest time step lower than timeReq, or the lowest one if timeReq is lower than all time steps.
       std::ostringstream oss; oss.precision(15); oss << "request for time " << timeReq << " but not in ";
       std::copy(ts.begin(),ts.end(),std::ostream_iterator<double>(oss,","));
-      oss << " ! Keep time " << valAttachedToPos << " at pos #" << zeTimeId;
+      oss << " ! Keep time " << ts[zeTimeId] << " at pos #" << zeTimeId;
       std::cerr << oss.str() << std::endl;
     }
-  MEDTimeReq *tr(0);
+  std::string cacheKey;
+  if(_cache.isActivated())
+    {
+      cacheKey=BuildCacheKey(isStdOrMode,zeTimeId,lev0,lev1,lev2,leaf,tk);
+      vtkDataSet *ret(_cache.retrieve(cacheKey));
+      if(ret)
+        return ret;
+    }
+  std::unique_ptr<MEDTimeReq> tr;
   if(!isStdOrMode)
-    tr=new MEDStdTimeReq((int)zeTimeId);
+    tr.reset(new MEDStdTimeReq((int)zeTimeId));
   else
-    tr=new MEDModeTimeReq(tk.getTheVectOfBool(),tk.getPostProcessedTime());
-  vtkDataSet *ret(leaf.buildVTKInstanceNoTimeInterpolation(tr,_fields,_ms,internalInfo));
-  delete tr;
+    tr.reset(new MEDModeTimeReq(tk.getTheVectOfBool(),tk.getPostProcessedTime()));
+  tr->setInterruptionFlag(interrupt);
+  vtkSmartPointer<vtkDataSet> ret;
+  ret.TakeReference(leaf.buildVTKInstanceNoTimeInterpolation(tr.get(),_fields,_ms,internalInfo,_nb_of_threads,_single_precision,&_timings,&_structured_coords));
+  if(_generate_vectors)
+    {// only arrays are added : the geometry shared with the support of the leaf is untouched, so the mesh MTime is the same for all time steps
+      vtkGenerateVectors::Operate(ret->GetPointData());
+      vtkGenerateVectors::Operate(ret->GetCellData());
+      vtkGenerateVectors::Operate(ret->GetFieldData());
+    }
+  if(_cache.isActivated())
+    _cache.store(cacheKey,ret);
+  ret->Register(0);// ownership given to the caller
   return ret;
 }
 
+/*!
+ * The key identifies the leaf, the time step(s) requested and the arrays activated in the leaf.
+ */
+std::string MEDFileFieldRepresentationTree::BuildCacheKey(bool isStdOrMode, std::size_t timeId, int lev0, int lev1, int lev2, const MEDFileFieldRepresentationLeaves& leaf, const TimeKeeper& tk)
+{
+  std::ostringstream oss; oss << lev0 << "/" << lev1 << "/" << lev2 << "/";
+  if(!isStdOrMode)
+    oss << timeId;
+  else
+    {
+      oss << "Mode" << tk.getPolicy() << ":";
+      std::vector<bool> v(tk.getTheVectOfBool());
+      for(std::vector<bool>::const_iterator it=v.begin();it!=v.end();it++)
+        oss << ((*it)?"1":"0");
+    }
+  oss << "/";
+  std::vector<int> ids(leaf.getActivatedIds());
+  std::copy(ids.begin(),ids.end(),std::ostream_iterator<int>(oss,","));
+  return oss.str();
+}
+
 const MEDFileFieldRepresentationLeaves& MEDFileFieldRepresentationTree::getTheSingleActivated(int& lev0, int& lev1, int& lev2) const
 {
   int nbOfActivated(0);
@@ -1488,6 +2860,8 @@ void MEDFileFieldRepresentationTree::printMySelf(std::ostream& os) const
 std::map<std::string,bool> MEDFileFieldRepresentationTree::dumpState() const
 {
   std::map<std::string,bool> ret;
+  for(int i=0;i<_index.getNumberOfLeavesArrays();i++)
+    ret[_index.getNameOf(i)]=_index.getStatusOf(i);
   for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
     for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
       for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
@@ -1495,6 +2869,20 @@ std::map<std::string,bool> MEDFileFieldRepresentationTree::dumpState() const
   return ret;
 }
 
+/*!
+ * Status of the arrays keyed by mesh name, field name and discretization. Unlike the one of dumpState, the key does not depend on the
+ * time series and the common support of the array, so it survives a change of the grouping of the fields.
+ */
+std::map<std::string,bool> MEDFileFieldRepresentationTree::dumpStatePerField() const
+{
+  std::map<std::string,bool> ret;
+  for(std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > >::const_iterator it0=_data_structure.begin();it0!=_data_structure.end();it0++)
+    for(std::vector< std::vector< MEDFileFieldRepresentationLeaves > >::const_iterator it1=(*it0).begin();it1!=(*it0).end();it1++)
+      for(std::vector< MEDFileFieldRepresentationLeaves >::const_iterator it2=(*it1).begin();it2!=(*it1).end();it2++)
+        (*it2).dumpStatePerField(ret);
+  return ret;
+}
+
 void MEDFileFieldRepresentationTree::AppendFieldFromMeshes(const MEDCoupling::MEDFileMeshes *ms, MEDCoupling::MEDFileFields *ret)
 {
   if(!ret)
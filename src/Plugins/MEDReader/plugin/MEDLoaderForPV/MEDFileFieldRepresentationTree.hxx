@@ -24,11 +24,18 @@
 #include "MEDFileMesh.hxx"
 #include "MEDFileField.hxx"
 #include "MEDLoaderForPV.h"
+#include "MEDFileFieldRepresentationIndex.hxx"
+#include "MEDUtilities.hxx"
 
 #include "vtkType.h"
 
 #include <vector>
+#include <list>
+#include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
 
 class vtkQuadratureSchemeDefinition;
 class vtkMutableDirectedGraph;
@@ -43,7 +50,7 @@ class vtkDataSet;
 
 class TimeKeeper;
 class MEDTimeReq;
-class ExportedTinyInfo;
+class FieldArrayToAttach;
 
 class ELGACmp
 {
@@ -56,13 +63,96 @@ private:
   vtkIdTypeArray *isExisting(const std::vector<std::string>& locsReallyUsed, vtkDataArray *vtkd) const;
   template<class T>
   vtkIdTypeArray *createNew(const MEDCoupling::MEDFileFieldGlobsReal *globs, const std::vector<std::string>& locsReallyUsed, vtkDataArray *vtkd, vtkDataSet *ds, ExportedTinyInfo *internalInfo) const;
+  static void ComputeOffsetsFromCellTypes(vtkDataSet *ds, const vtkIdType nbOfValuesPerType[256], vtkIdType *offsets);
+  static std::string BuildLocKey(const std::vector<std::string>& locsReallyUsed);
 private:
   //! size of _loc_names is equal to _elgas.
   mutable std::vector< std::vector<std::string> > _loc_names;
+  //! position in _loc_names of each entry, the key being computed by BuildLocKey.
+  mutable std::unordered_map<std::string,std::size_t> _pos_per_loc_key;
   //! size of _elgas is equal to _loc_names. All instances in _elgas are \b not null.
   mutable std::vector<vtkIdTypeArray *> _elgas;
   //! same size than _loc_names and _elgas.
   mutable std::vector< std::vector< std::pair< vtkQuadratureSchemeDefinition *, unsigned char > > > _defs;
+  //! definitions are shared between the entries using the same localization. Owner of the definitions.
+  mutable std::map<std::string,vtkQuadratureSchemeDefinition *> _def_per_loc;
+};
+
+/*!
+ * Offsets and quadrature definitions of ELNO fields. They only depend on the support, so they are computed once per leaf
+ * and the buffer of the offsets is shared by all the ELNO fields of the leaf. A copy of an instance is empty.
+ */
+class ELNOCache
+{
+public:
+  ELNOCache():_offsets(0) { }
+  ELNOCache(const ELNOCache&):_offsets(0) { }
+  ELNOCache& operator=(const ELNOCache& other);
+  ~ELNOCache();
+  void attachOffsetsTo(vtkDataArray *vtkd, const std::string& name, vtkDataSet *ds) const;
+private:
+  void clear() const;
+  void initialize(vtkDataSet *ds) const;
+private:
+  mutable vtkIdTypeArray *_offsets;
+  mutable std::vector< std::pair< vtkQuadratureSchemeDefinition *, unsigned char > > _defs;
+};
+
+/*!
+ * Memory budgeted LRU cache of the datasets built by MEDFileFieldRepresentationTree::buildVTKInstance.
+ * Only the attribute arrays owned by an entry are accounted : the geometry, the family/number arrays and the ELGA/ELNO offsets are
+ * shared between all the entries of a same leaf, and zero copy arrays belong to MEDCoupling.
+ */
+class MEDLOADERFORPV_EXPORT DataSetLRUCache
+{
+public:
+  DataSetLRUCache();
+  ~DataSetLRUCache();
+  void setSizeLimit(int sizeInMB) const;
+  int getSizeLimit() const { return _size_limit_in_mb; }
+  bool isActivated() const { return _size_limit_in_mb>0; }
+  vtkDataSet *retrieve(const std::string& key) const;
+  void store(const std::string& key, vtkDataSet *ds) const;
+  void clear() const;
+  unsigned long getSizeInKB() const { return _size_in_kb; }
+  int getNumberOfHits() const { return _nb_of_hits; }
+  int getNumberOfMisses() const { return _nb_of_misses; }
+  static unsigned long ComputeSizeInKB(vtkDataSet *ds);
+private:
+  DataSetLRUCache(const DataSetLRUCache&); // Not implemented.
+  void operator=(const DataSetLRUCache&); // Not implemented.
+  void evictIfNecessary() const;
+private:
+  //! the size of each entry is computed once when stored
+  typedef std::list< std::pair<std::string, std::pair<vtkDataSet *,unsigned long> > > EntriesType;
+  mutable int _size_limit_in_mb;
+  mutable unsigned long _size_in_kb;
+  mutable int _nb_of_hits;
+  mutable int _nb_of_misses;
+  //! most recently used first
+  mutable EntriesType _entries;
+  mutable std::map<std::string,EntriesType::iterator> _index;
+};
+
+/*!
+ * Coordinates of the structured meshes as given to VTK, shared by all the leaves lying on a same mesh : axes of the cartesian meshes
+ * and points of the curvilinear meshes, padded to 3 components once for all if needed. Arrays may point to the coordinates of the
+ * meshes in memory, so the cache has to be cleared before the meshes are released.
+ */
+class MEDLOADERFORPV_EXPORT StructuredCoordsCache
+{
+public:
+  StructuredCoordsCache() { }
+  ~StructuredCoordsCache();
+  std::vector<vtkDataArray *> retrieve(const std::string& meshName, bool singlePrecision, const std::vector<vtkIdType>& nbOfTuples) const;
+  void store(const std::string& meshName, bool singlePrecision, const std::vector<vtkDataArray *>& arrs) const;
+  void clear() const;
+private:
+  StructuredCoordsCache(const StructuredCoordsCache&); // Not implemented.
+  void operator=(const StructuredCoordsCache&); // Not implemented.
+private:
+  mutable std::mutex _mutex;
+  mutable std::map< std::pair<std::string,bool>, std::vector<vtkDataArray *> > _arrays;
 };
 
 class MEDLOADERFORPV_EXPORT MEDFileFieldRepresentationLeavesArrays : public MEDCoupling::MCAuto<MEDCoupling::MEDFileAnyTypeFieldMultiTS>
@@ -79,7 +169,12 @@ public:
   bool setStatus(bool status) const;
   std::string getZeName() const;
   const char *getZeNameC() const;
-  void appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, vtkDataSet *ds, ExportedTinyInfo *internalInfo) const;
+  std::string getZeShortName() const { return _ze_name; }
+  void appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, vtkDataSet *ds, const ELNOCache& elnoCache, ExportedTinyInfo *internalInfo, bool singlePrecision=false, MEDReaderTimings *timings=0) const;
+  void prepareFields(const MEDTimeReq *tr, std::vector<FieldArrayToAttach>& items, bool singlePrecision=false) const;
+  void loadField(const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, FieldArrayToAttach& item, MEDReaderTimings *timings=0) const;
+  void computeOffsets(const FieldArrayToAttach& item, const MEDCoupling::MEDFileFieldGlobsReal *globs, vtkDataSet *ds, ExportedTinyInfo *internalInfo, MEDReaderTimings *timings=0) const;
+  void attachField(const FieldArrayToAttach& item, vtkDataSet *ds, const ELNOCache& elnoCache) const;
   void appendELGAIfAny(vtkDataSet *ds) const;
 public:
   static const char ZE_SEP[];
@@ -108,30 +203,68 @@ public:
   bool empty() const;
   void setId(int& id) const;
   std::string getMeshName() const;
+  std::string getSupportKey() const;
   int getNumberOfArrays() const;
   int getNumberOfTS() const;
   void feedSIL(const MEDCoupling::MEDFileMeshes *ms, const std::string& meshName, vtkMutableDirectedGraph* sil, vtkIdType root, vtkVariantArray *edge, std::vector<std::string>& names) const;
   void computeFullNameInLeaves(const std::string& tsName, const std::string& meshName, const std::string& comSupStr) const;
   bool containId(int id) const;
   bool containZeName(const char *name, int& id) const;
+  void fillLookupIndex(std::unordered_map<std::string,int>& idPerName, std::vector<const MEDFileFieldRepresentationLeavesArrays *>& leafArrPerId) const;
   void dumpState(std::map<std::string,bool>& status) const;
+  void dumpStatePerField(std::map<std::string,bool>& status) const;
+  void fillIdPerField(std::map<std::string,int>& idPerField) const;
   bool isActivated() const;
+  std::vector<int> getActivatedIds() const;
   void printMySelf(std::ostream& os) const;
   void activateAllArrays() const;
+  void deactivateAllArrays() const;
   const MEDFileFieldRepresentationLeavesArrays& getLeafArr(int id) const;
   std::vector<double> getTimeSteps(const TimeKeeper& tk) const;
   std::vector< std::pair<int,int> > getTimeStepsInCoarseMEDFileFormat(std::vector<double>& ts) const;
   std::string getHumanReadableOverviewOfTS() const;
-  vtkDataSet *buildVTKInstanceNoTimeInterpolation(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDFileMeshes *meshes, ExportedTinyInfo *internalInfo=0) const;
+  std::vector<std::string> getGeoTypesRepr(const MEDCoupling::MEDFileMeshes *ms, const std::string& meshName) const;
+  void fillIndex(const MEDCoupling::MEDFileMeshes *ms, const std::string& meshName, MEDFileFieldRepresentationIndex::Leaf& leaf) const;
+  vtkDataSet *buildVTKInstanceNoTimeInterpolation(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDFileMeshes *meshes, ExportedTinyInfo *internalInfo=0, int nbOfThreads=1, bool singlePrecision=false, MEDReaderTimings *timings=0, const StructuredCoordsCache *coordsCache=0) const;
 private:
-  vtkUnstructuredGrid *buildVTKInstanceNoTimeInterpolationUnstructured(MEDCoupling::MEDUMeshMultiLev *mm) const;
-  vtkRectilinearGrid *buildVTKInstanceNoTimeInterpolationCartesian(MEDCoupling::MEDCMeshMultiLev *mm) const;
-  vtkStructuredGrid *buildVTKInstanceNoTimeInterpolationCurveLinear(MEDCoupling::MEDCurveLinearMeshMultiLev *mm) const;
-  void appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshes *meshes, vtkDataSet *ds, ExportedTinyInfo *internalInfo=0) const;
+  vtkUnstructuredGrid *buildVTKInstanceNoTimeInterpolationUnstructured(MEDCoupling::MEDUMeshMultiLev *mm, bool singlePrecision) const;
+  vtkRectilinearGrid *buildVTKInstanceNoTimeInterpolationCartesian(MEDCoupling::MEDCMeshMultiLev *mm, bool singlePrecision, const StructuredCoordsCache *coordsCache) const;
+  vtkStructuredGrid *buildVTKInstanceNoTimeInterpolationCurveLinear(MEDCoupling::MEDCurveLinearMeshMultiLev *mm, bool singlePrecision, const StructuredCoordsCache *coordsCache) const;
+  void appendFields(const MEDTimeReq *tr, const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDMeshMultiLev *mml, const MEDCoupling::MEDFileMeshStruct *mst, vtkDataSet *ds, ExportedTinyInfo *internalInfo=0, int nbOfThreads=1, bool singlePrecision=false, MEDReaderTimings *timings=0) const;
+  void buildMeshSupportIfNeeded(const MEDCoupling::MEDFileFieldGlobsReal *globs, const MEDCoupling::MEDFileMeshes *meshes, bool singlePrecision, MEDReaderTimings *timings=0, const StructuredCoordsCache *coordsCache=0) const;
+  void clearMeshSupport() const;
+  void takeMeshSupportFrom(const MEDFileFieldRepresentationLeaves& other) const;
+  void appendMeshArrays(vtkDataSet *ds) const;
 private:
   std::vector<MEDFileFieldRepresentationLeavesArrays> _arrays;
   MEDCoupling::MCAuto<MEDCoupling::MEDFileFastCellSupportComparator> _fsp;
+  //! geometry without any attribute. Built at the first call of buildVTKInstanceNoTimeInterpolation as all the following members.
   mutable vtkDataSet *_cached_ds;
+  //! precision of the coordinates and of the numbering arrays of _cached_ds.
+  mutable bool _cached_single_precision;
+  mutable MEDCoupling::MCAuto<MEDCoupling::MEDMeshMultiLev> _cached_mml;
+  mutable MEDCoupling::MCAuto<MEDCoupling::MEDMeshMultiLev> _cached_mml2;
+  mutable MEDCoupling::MCAuto<MEDCoupling::MEDFileMeshStruct> _cached_mst;
+  //! families, numbers and global node ids. Appended after the fields to each dataset built.
+  mutable std::vector<vtkDataArray *> _cached_cell_arrs;
+  mutable std::vector<vtkDataArray *> _cached_node_arrs;
+  ELNOCache _elno_cache;
+};
+
+/*!
+ * Time steps of a leaf sorted once for all, to find by binary search the time step matching a time requested by the pipeline.
+ */
+class TimeIndex
+{
+public:
+  void update(const std::vector<double>& ts) const;
+  std::size_t find(double timeReq, bool& isExact) const;
+public:
+  static const double EPS;
+private:
+  mutable std::vector<double> _ts;
+  //! values of _ts sorted, with their position in _ts. Equal values are sorted by position.
+  mutable std::vector< std::pair<double,std::size_t> > _sorted;
 };
 
 class MEDLOADERFORPV_EXPORT MEDFileFieldRepresentationTree
@@ -154,32 +287,106 @@ public:
   //
   std::string getDftMeshName() const;
   std::vector<double> getTimeSteps(int& lev0, const TimeKeeper& tk) const;
-  vtkDataSet *buildVTKInstance(bool isStdOrMode, double timeReq, std::string& meshName, const TimeKeeper& tk, ExportedTinyInfo *internalInfo=0) const;
+  vtkDataSet *buildVTKInstance(bool isStdOrMode, double timeReq, std::string& meshName, const TimeKeeper& tk, ExportedTinyInfo *internalInfo=0, const std::atomic<bool> *interrupt=0) const;
+  void setCacheSizeLimit(int sizeInMB) const { _cache.setSizeLimit(sizeInMB); }
+  int getCacheSizeLimit() const { return _cache.getSizeLimit(); }
+  int getNumberOfCacheHits() const { return _cache.getNumberOfHits(); }
+  int getNumberOfCacheMisses() const { return _cache.getNumberOfMisses(); }
+  void setNumberOfThreads(int nbOfThreads) { _nb_of_threads=std::max(nbOfThreads,1); }
+  int getNumberOfThreads() const { return _nb_of_threads; }
+  void setLazyMeshLoading(bool lazy) { _lazy_mesh_loading=lazy; }
+  bool getLazyMeshLoading() const { return _lazy_mesh_loading; }
+  void setWeightedPartitioning(bool weighted) { _weighted_partitioning=weighted; }
+  bool getWeightedPartitioning() const { return _weighted_partitioning; }
+  void setGeoTypesToLoad(const std::vector<INTERP_KERNEL::NormalizedCellType>& geoTypes) { _geo_types_to_load=geoTypes; }
+  const std::vector<INTERP_KERNEL::NormalizedCellType>& getGeoTypesToLoad() const { return _geo_types_to_load; }
+  void setSinglePrecision(bool singlePrecision);
+  bool getSinglePrecision() const { return _single_precision; }
+  void setGenerateVectors(bool generateVectors);
+  bool getGenerateVectors() const { return _generate_vectors; }
+  //! Timings of the stages run by this. Stages run by the reader (ghost cells, SIL) are recorded in it too.
+  MEDReaderTimings& getTimings() const { return _timings; }
+  //! Incremented each time the structure (leaves, names, ids) is (re)loaded. Everything derived from the structure is outdated when it changes.
+  int getStructureStamp() const { return _structure_stamp; }
   void printMySelf(std::ostream& os) const;
   std::map<std::string,bool> dumpState() const;
+  std::map<std::string,bool> dumpStatePerField() const;
   //non const methods
   void loadMainStructureOfFile(const char *fileName, int iPart, int nbOfParts);
+  bool reloadFieldsStructure(int iPart, int nbOfParts);
   void loadInMemory(MEDCoupling::MEDFileFields *fields, MEDCoupling::MEDFileMeshes *meshes);
   void removeEmptyLeaves();
+  bool loadIndexOfFile(const char *fileName, const std::string& indexFileName);
+  void saveIndexOfFile(const char *fileName, const std::string& indexFileName) const;
+  bool isIndexOnly() const { return _index.isLoaded(); }
+  void loadMainStructureOfFileIfIndexOnly(const char *fileName, int iPart, int nbOfParts);
+  void completeActivatedMeshIfNeeded();
   // static methods
   static bool IsFieldMeshRegardingInfo(const std::vector<std::string>& compInfos);
   static std::string PostProcessFieldName(const std::string& fullFieldName);
+  static std::mutex& GetHDF5Mutex();
+  static std::vector<INTERP_KERNEL::NormalizedCellType> ParseGeoTypes(const std::string& geoTypes);
+  static std::vector<mcIdType> ComputeWeightedSlices(const std::vector< std::pair<INTERP_KERNEL::NormalizedCellType,mcIdType> >& nbOfCellsPerType,
+                                                     const std::map<INTERP_KERNEL::NormalizedCellType,int>& nbOfGaussPtsPerType, int iPart, int nbOfParts);
 public:
   static const char ROOT_OF_GRPS_IN_TREE[];
   static const char ROOT_OF_FAM_IDS_IN_TREE[];
   static const char COMPO_STR_TO_LOCATE_MESH_DA[];
+  //! estimated number of nodes per cell of the dynamic types, used to weight them in ComputeWeightedSlices.
+  static const int WEIGHT_OF_POLYHEDRON;
+  static const int WEIGHT_OF_QPOLYGON;
+  static const int WEIGHT_OF_POLYGON;
 private:
   const MEDFileFieldRepresentationLeavesArrays& getLeafArr(int id) const;
   const MEDFileFieldRepresentationLeaves& getTheSingleActivated(int& lev0, int& lev1, int& lev2) const;
+  void fillIndex(MEDFileFieldRepresentationIndex& idx) const;
+  void buildLookupIndex();
+  static MEDCoupling::MEDFileMeshes *LoadMeshesWithoutPerEntityArrays(const char *fileName);
+  static med_geometry_type ConvertToMEDGeoType(INTERP_KERNEL::NormalizedCellType ct);
+  static void ReadPerEntityArrays(med_idt fid, MEDCoupling::MEDFileMesh *mesh, int meshDimRelToMaxExt, med_entity_type entity,
+                                  const std::vector< std::pair<med_geometry_type,mcIdType> >& entities);
+  static MEDCoupling::MEDFileMeshes *LoadPartOfMeshes(const char *fileName, int iPart, int nbOfParts, const std::vector<INTERP_KERNEL::NormalizedCellType>& geoTypes);
+  static void ZipCoordsOfUMeshes(MEDCoupling::MEDFileMeshes *ms);
   static MEDCoupling::MEDFileFields *BuildFieldFromMeshes(const MEDCoupling::MEDFileMeshes *ms);
   static void AppendFieldFromMeshes(const MEDCoupling::MEDFileMeshes *ms, MEDCoupling::MEDFileFields *ret);
   static std::string BuildAUniqueArrayNameForMesh(const std::string& meshName, const MEDCoupling::MEDFileFields *ret);
   static std::vector<std::string> SplitFieldNameIntoParts(const std::string& fullFieldName, char sep);
+  static std::string BuildFieldsSignature(const MEDCoupling::MEDFileFields *fields);
+  static std::string BuildCacheKey(bool isStdOrMode, std::size_t timeId, int lev0, int lev1, int lev2, const MEDFileFieldRepresentationLeaves& leaf, const TimeKeeper& tk);
 private:
   // 1st : timesteps, 2nd : meshName, 3rd : common support
   std::vector< std::vector< std::vector< MEDFileFieldRepresentationLeaves > > > _data_structure;
   MEDCoupling::MCAuto<MEDCoupling::MEDFileMeshes> _ms;
   MEDCoupling::MCAuto<MEDCoupling::MEDFileFields> _fields;
+  //! declared after _ms because its arrays may point to the coordinates of _ms.
+  StructuredCoordsCache _structured_coords;
+  //! number of threads used to read and convert the arrays of a time step.
+  int _nb_of_threads;
+  //! when true, the family, numbering and name arrays of a mesh are read only when one of its leaves is activated.
+  bool _lazy_mesh_loading;
+  //! when true, in parallel, each geometric type is split among the ranks so that the cost of the cells (nodes and Gauss points) is balanced.
+  bool _weighted_partitioning;
+  //! when not empty, only the cells of these geometric types, and the values of the fields lying on them, are read.
+  std::vector<INTERP_KERNEL::NormalizedCellType> _geo_types_to_load;
+  //! when true, coordinates and FLOAT64 fields are given to VTK in float32, and numbering arrays in int32 when their range allows it.
+  bool _single_precision;
+  //! when true the 3 components vector arrays are generated with the dataset, and kept with it in the cache
+  bool _generate_vectors;
+  int _structure_stamp;
+  std::string _file_name;
+  //! fields and time steps read by the last load. Used by reloadFieldsStructure to detect changes on disk.
+  std::string _fields_signature;
+  //! meshes loaded without their family, numbering and name arrays.
+  std::vector<std::string> _incomplete_meshes;
+  //! declared after _fields because cached datasets may point to the arrays of _fields.
+  DataSetLRUCache _cache;
+  //! when loaded, the structure comes from the index on disk and _data_structure is empty.
+  MEDFileFieldRepresentationIndex _index;
+  //! built by buildLookupIndex from _data_structure. Ids being contiguous, _leaf_arr_per_id is indexed by id.
+  std::unordered_map<std::string,int> _id_per_name;
+  std::vector<const MEDFileFieldRepresentationLeavesArrays *> _leaf_arr_per_id;
+  TimeIndex _time_index;
+  mutable MEDReaderTimings _timings;
 };
 
 class MEDLOADERFORPV_EXPORT TimeKeeper
@@ -20,12 +20,24 @@
 
 #include "MEDTimeReq.hxx"
 
+#include "InterpKernelException.hxx"
+
 #include <sstream>
 
+MEDTimeReq::MEDTimeReq():_interrupt(0)
+{
+}
+
 MEDTimeReq::~MEDTimeReq()
 {
 }
 
+void MEDTimeReq::checkNotInterrupted() const
+{
+  if(_interrupt && _interrupt->load())
+    throw INTERP_KERNEL::Exception("MEDTimeReq::checkNotInterrupted : build of the dataset has been interrupted !");
+}
+
 ///////////
 
 MEDStdTimeReq::~MEDStdTimeReq()
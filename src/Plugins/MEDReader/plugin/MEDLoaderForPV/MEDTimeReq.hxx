@@ -23,6 +23,7 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
 
 #include "MEDLoaderForPV.h"
 
@@ -36,6 +37,13 @@ public:
   virtual int getCurrent() const = 0;
   virtual void operator++() const = 0;
   virtual ~MEDTimeReq();
+  void setInterruptionFlag(const std::atomic<bool> *interrupt) { _interrupt=interrupt; }
+  void checkNotInterrupted() const;
+protected:
+  MEDTimeReq();
+private:
+  //! not owned. When not null and set to true, the build of the dataset is aborted (asynchronous prefetch).
+  const std::atomic<bool> *_interrupt;
 };
 
 class MEDLOADERFORPV_EXPORT MEDStdTimeReq : public MEDTimeReq
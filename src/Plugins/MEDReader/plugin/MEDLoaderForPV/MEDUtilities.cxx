@@ -24,9 +24,11 @@
 #include "vtkInformationQuadratureSchemeDefinitionVectorKey.h"
 
 #include <algorithm>
+#include <sstream>
 
 vtkInformationKeyMacro(MEDUtilities,ELGA,Integer)
 vtkInformationKeyMacro(MEDUtilities,ELNO,Integer)
+vtkInformationKeyMacro(MEDUtilities,SHARED_MEMORY,Integer)
 
 void ExportedTinyInfo::pushGaussAdditionnalInfo(int ct, int dim, const std::vector<double>& refCoo, const std::vector<double>& posInRefCoo)
 {
@@ -39,6 +41,22 @@ void ExportedTinyInfo::pushGaussAdditionnalInfo(int ct, int dim, const std::vect
   _data.insert(_data.end(),tmp.begin(),tmp.end());
 }
 
+/*!
+ * Appends the definitions of \a other after the ones of \a this, as if they had been pushed in \a this.
+ */
+void ExportedTinyInfo::append(const ExportedTinyInfo& other)
+{
+  if(other._data.empty())
+    return ;
+  if(_data.empty())
+    {
+      _data=other._data;
+      return ;
+    }
+  _data[0]=(double)((int)_data[0]+(int)other._data[0]);
+  _data.insert(_data.end(),other._data.begin()+1,other._data.end());
+}
+
 void ExportedTinyInfo::prepareForAppend()
 {
   if(_data.empty())
@@ -50,3 +68,101 @@ void ExportedTinyInfo::prepareForAppend()
       _data[0]=++val2;
     }
 }
+
+MEDReaderTimings::MEDReaderTimings():_request(0)
+{
+  reset();
+}
+
+/*!
+ * Marks the beginning of a new request. The last values of a stage are the ones recorded during the last request in which it has been run.
+ */
+void MEDReaderTimings::startRequest()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _request++;
+}
+
+void MEDReaderTimings::add(Stage stage, double seconds, unsigned long long nbOfBytes)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if(_last_request[stage]!=_request)
+    {
+      _last_time[stage]=0.; _last_bytes[stage]=0;
+      _last_request[stage]=_request;
+    }
+  _cumulative_time[stage]+=seconds; _last_time[stage]+=seconds;
+  _cumulative_bytes[stage]+=nbOfBytes; _last_bytes[stage]+=nbOfBytes;
+  _nb_of_calls[stage]++;
+}
+
+void MEDReaderTimings::reset()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  for(int i=0;i<NB_OF_STAGES;i++)
+    {
+      _cumulative_time[i]=0.; _last_time[i]=0.;
+      _cumulative_bytes[i]=0; _last_bytes[i]=0;
+      _nb_of_calls[i]=0; _last_request[i]=-1;
+    }
+}
+
+double MEDReaderTimings::getCumulativeTime(Stage stage) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _cumulative_time[stage];
+}
+
+double MEDReaderTimings::getLastTime(Stage stage) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _last_time[stage];
+}
+
+unsigned long long MEDReaderTimings::getCumulativeBytes(Stage stage) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _cumulative_bytes[stage];
+}
+
+unsigned long long MEDReaderTimings::getLastBytes(Stage stage) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _last_bytes[stage];
+}
+
+int MEDReaderTimings::getNumberOfCalls(Stage stage) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _nb_of_calls[stage];
+}
+
+/*!
+ * One line per stage : name, cumulative time, last time, cumulative bytes, last bytes and number of calls separated by spaces.
+ */
+std::string MEDReaderTimings::getReport() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::ostringstream oss; oss.precision(9);
+  for(int i=0;i<NB_OF_STAGES;i++)
+    oss << GetStageName((Stage)i) << " " << _cumulative_time[i] << " " << _last_time[i] << " " << _cumulative_bytes[i] << " " << _last_bytes[i] << " " << _nb_of_calls[i] << std::endl;
+  return oss.str();
+}
+
+const char *MEDReaderTimings::GetStageName(Stage stage)
+{
+  static const char *NAMES[NB_OF_STAGES]={"FileOpen","LoadInMemory","ArrayRead","BuildVTUArrays","ELGAOffsets","GhostCells","SIL"};
+  return NAMES[stage];
+}
+
+MEDReaderStageTimer::MEDReaderStageTimer(MEDReaderTimings *timings, MEDReaderTimings::Stage stage):_timings(timings),_stage(stage),_start(std::chrono::steady_clock::now()),_nb_of_bytes(0)
+{
+}
+
+MEDReaderStageTimer::~MEDReaderStageTimer()
+{
+  if(!_timings)
+    return ;
+  std::chrono::duration<double> elapsed(std::chrono::steady_clock::now()-_start);
+  _timings->add(_stage,elapsed.count(),_nb_of_bytes);
+}
@@ -25,6 +25,9 @@
 #include "vtkCellType.h"
 
 #include <vector>
+#include <string>
+#include <mutex>
+#include <chrono>
 
 class vtkInformationIntegerKey;
 
@@ -33,12 +36,15 @@ class MEDLOADERFORPV_EXPORT MEDUtilities
 public:
   static vtkInformationIntegerKey *ELGA();
   static vtkInformationIntegerKey *ELNO();
+  //! set on the VTK arrays whose memory is not owned by the dataset they are attached to : zero copy of MEDCoupling arrays, arrays kept by a leaf
+  static vtkInformationIntegerKey *SHARED_MEMORY();
 };
 
 class ExportedTinyInfo
 {
 public:
   void pushGaussAdditionnalInfo(int ct, int dim, const std::vector<double>& refCoo, const std::vector<double>& posInRefCoo);
+  void append(const ExportedTinyInfo& other);
   const std::vector<double>& getData() const { return _data; }
   bool empty() const { return _data.empty(); }
 private:
@@ -56,4 +62,53 @@ private:
   std::vector<double> _data;
 };
 
+/*!
+ * Durations (in seconds) and amounts of bytes spent in each stage of the load of a MED file, cumulated since the creation and for the last request.
+ * Thread safe : stages run by worker threads are accumulated concurrently.
+ */
+class MEDLOADERFORPV_EXPORT MEDReaderTimings
+{
+public:
+  enum Stage { FILE_OPEN=0, LOAD_IN_MEMORY, ARRAY_READ, BUILD_VTU_ARRAYS, ELGA_OFFSETS, GHOST_CELLS, SIL, NB_OF_STAGES };
+  MEDReaderTimings();
+  void startRequest();
+  void add(Stage stage, double seconds, unsigned long long nbOfBytes);
+  void reset();
+  double getCumulativeTime(Stage stage) const;
+  double getLastTime(Stage stage) const;
+  unsigned long long getCumulativeBytes(Stage stage) const;
+  unsigned long long getLastBytes(Stage stage) const;
+  int getNumberOfCalls(Stage stage) const;
+  std::string getReport() const;
+  static const char *GetStageName(Stage stage);
+private:
+  mutable std::mutex _mutex;
+  int _request;
+  double _cumulative_time[NB_OF_STAGES];
+  double _last_time[NB_OF_STAGES];
+  unsigned long long _cumulative_bytes[NB_OF_STAGES];
+  unsigned long long _last_bytes[NB_OF_STAGES];
+  int _nb_of_calls[NB_OF_STAGES];
+  //! request during which the last values of the stage have been recorded
+  int _last_request[NB_OF_STAGES];
+};
+
+/*!
+ * Records in \a timings, at its destruction, the time elapsed since its construction. Nothing is done if \a timings is null.
+ */
+class MEDLOADERFORPV_EXPORT MEDReaderStageTimer
+{
+public:
+  MEDReaderStageTimer(MEDReaderTimings *timings, MEDReaderTimings::Stage stage);
+  ~MEDReaderStageTimer();
+  void setNumberOfBytes(unsigned long long nbOfBytes) { _nb_of_bytes=nbOfBytes; }
+  //! the elapsed time is not recorded
+  void cancel() { _timings=0; }
+private:
+  MEDReaderTimings *_timings;
+  MEDReaderTimings::Stage _stage;
+  std::chrono::steady_clock::time_point _start;
+  unsigned long long _nb_of_bytes;
+};
+
 #endif
@@ -21,6 +21,7 @@
 #include "vtkGenerateVectors.h"
 #include "vtkAOSDataArrayTemplate.h"
 #include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkQuadratureSchemeDefinition.h"
@@ -49,31 +50,49 @@ void vtkGenerateVectors::ChangeMeshTimeToUpdateCache(vtkDataSet *dataset)
   ug->GetPoints()->Modified();
 }
 
+/*!
+ * Adds to \a fd the 3 components version of its arrays having 2 or more than 3 components. Existing arrays are not modified, so that
+ * applied on the attributes of a dataset the geometry and the mesh MTime are untouched.
+ * Arrays already having their vector counterpart in \a fd are skipped : applying it twice on the same \a fd is harmless.
+ */
 void vtkGenerateVectors::Operate(vtkFieldData *fd)
 {
   if(!fd)
     return ;
   const int nbOfArrs(fd->GetNumberOfArrays());
-  std::vector<vtkDoubleArray *> daToAppend;
+  std::vector<vtkDataArray *> daToAppend;
   for(int i=0;i<nbOfArrs;i++)
     {
       vtkDataArray *arr(fd->GetArray(i));
       if(!arr)
         continue;
       vtkDoubleArray *arrc(vtkDoubleArray::SafeDownCast(arr));
-      if(!arrc)
+      vtkFloatArray *arrf(vtkFloatArray::SafeDownCast(arr));
+      if(!arrc && !arrf)
         continue;
-      int nbOfCompo(arrc->GetNumberOfComponents());
+      int nbOfCompo(arr->GetNumberOfComponents());
       if(nbOfCompo<=1 || nbOfCompo==3)
         continue;
-      if(nbOfCompo==2)
-        daToAppend.push_back(Operate2Compo(arrc));
+      if(!arr->GetName() || fd->GetAbstractArray(SuffixFieldName(arr->GetName()).c_str()))
+        continue;
+      if(arrc)
+        {
+          if(nbOfCompo==2)
+            daToAppend.push_back(Operate2Compo(arrc));
+          else
+            daToAppend.push_back(OperateMoreThan3Compo(arrc));
+        }
       else
-        daToAppend.push_back(OperateMoreThan3Compo(arrc));
+        {
+          if(nbOfCompo==2)
+            daToAppend.push_back(Operate2Compo(arrf));
+          else
+            daToAppend.push_back(OperateMoreThan3Compo(arrf));
+        }
     }
-  for(std::vector<vtkDoubleArray *>::const_iterator it=daToAppend.begin();it!=daToAppend.end();it++)
+  for(std::vector<vtkDataArray *>::const_iterator it=daToAppend.begin();it!=daToAppend.end();it++)
     {
-      vtkDoubleArray *elt(*it);
+      vtkDataArray *elt(*it);
       if(!elt)
 	continue;
       fd->AddArray(elt);
@@ -83,11 +102,36 @@ void vtkGenerateVectors::Operate(vtkFieldData *fd)
 
 vtkDoubleArray *vtkGenerateVectors::Operate2Compo(vtkDoubleArray *oldArr)
 {
-  const int VTK_DATA_ARRAY_FREE=vtkAOSDataArrayTemplate<double>::VTK_DATA_ARRAY_FREE;
-  vtkDoubleArray *ret(vtkDoubleArray::New());
+  return Operate2CompoT<vtkDoubleArray>(oldArr);
+}
+
+vtkDoubleArray *vtkGenerateVectors::OperateMoreThan3Compo(vtkDoubleArray *oldArr)
+{
+  return OperateMoreThan3CompoT<vtkDoubleArray>(oldArr);
+}
+
+/*!
+ * Float arrays are generated by the MEDReader when single precision is requested.
+ */
+vtkFloatArray *vtkGenerateVectors::Operate2Compo(vtkFloatArray *oldArr)
+{
+  return Operate2CompoT<vtkFloatArray>(oldArr);
+}
+
+vtkFloatArray *vtkGenerateVectors::OperateMoreThan3Compo(vtkFloatArray *oldArr)
+{
+  return OperateMoreThan3CompoT<vtkFloatArray>(oldArr);
+}
+
+template<class VTKARRAY>
+VTKARRAY *vtkGenerateVectors::Operate2CompoT(VTKARRAY *oldArr)
+{
+  typedef typename VTKARRAY::ValueType T;
+  const int VTK_DATA_ARRAY_FREE=vtkAOSDataArrayTemplate<T>::VTK_DATA_ARRAY_FREE;
+  VTKARRAY *ret(VTKARRAY::New());
   vtkIdType nbOfTuples(oldArr->GetNumberOfTuples());
-  const double *inPt(oldArr->GetPointer(0));
-  double *pt((double *)malloc(nbOfTuples*3*sizeof(double)));
+  const T *inPt(oldArr->GetPointer(0));
+  T *pt((T *)malloc(nbOfTuples*3*sizeof(T)));
   for(vtkIdType i=0;i<nbOfTuples;i++)
     {
       pt[3*i+0]=inPt[2*i+0];
@@ -104,14 +148,16 @@ vtkDoubleArray *vtkGenerateVectors::Operate2Compo(vtkDoubleArray *oldArr)
   return ret;
 }
 
-vtkDoubleArray *vtkGenerateVectors::OperateMoreThan3Compo(vtkDoubleArray *oldArr)
+template<class VTKARRAY>
+VTKARRAY *vtkGenerateVectors::OperateMoreThan3CompoT(VTKARRAY *oldArr)
 {
-  const int VTK_DATA_ARRAY_FREE=vtkAOSDataArrayTemplate<double>::VTK_DATA_ARRAY_FREE;
-  vtkDoubleArray *ret(vtkDoubleArray::New());
+  typedef typename VTKARRAY::ValueType T;
+  const int VTK_DATA_ARRAY_FREE=vtkAOSDataArrayTemplate<T>::VTK_DATA_ARRAY_FREE;
+  VTKARRAY *ret(VTKARRAY::New());
   int nbOfCompo(oldArr->GetNumberOfComponents());
   vtkIdType nbOfTuples(oldArr->GetNumberOfTuples());
-  const double *inPt(oldArr->GetPointer(0));
-  double *pt((double *)malloc(nbOfTuples*3*sizeof(double)));
+  const T *inPt(oldArr->GetPointer(0));
+  T *pt((T *)malloc(nbOfTuples*3*sizeof(T)));
   for(vtkIdType i=0;i<nbOfTuples;i++)
     {
       pt[3*i+0]=inPt[nbOfCompo*i+0];
@@ -129,7 +175,7 @@ vtkDoubleArray *vtkGenerateVectors::OperateMoreThan3Compo(vtkDoubleArray *oldArr
   return ret;
 }
 
-void vtkGenerateVectors::UpdateInformationOfArray(vtkDoubleArray *oldArr, vtkDoubleArray *arr)
+void vtkGenerateVectors::UpdateInformationOfArray(vtkDataArray *oldArr, vtkDataArray *arr)
 {
   if(oldArr->GetInformation()->Has(vtkQuadratureSchemeDefinition::QUADRATURE_OFFSET_ARRAY_NAME()))
     {
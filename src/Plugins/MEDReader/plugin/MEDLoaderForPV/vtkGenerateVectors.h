@@ -24,7 +24,9 @@
 #include "vtkDataSetAlgorithm.h"
 
 class vtkFieldData;
+class vtkDataArray;
 class vtkDoubleArray;
+class vtkFloatArray;
 
 class VTK_EXPORT vtkGenerateVectors
 {
@@ -33,11 +35,17 @@ public:
   static void Operate(vtkFieldData *fd);
   static vtkDoubleArray *Operate2Compo(vtkDoubleArray *oldArr);
   static vtkDoubleArray *OperateMoreThan3Compo(vtkDoubleArray *oldArr);
+  static vtkFloatArray *Operate2Compo(vtkFloatArray *oldArr);
+  static vtkFloatArray *OperateMoreThan3Compo(vtkFloatArray *oldArr);
   static std::string SuffixFieldName(const std::string& name);
 public:
   static const char VECTOR_SUFFIX[];
 protected:
-  static void UpdateInformationOfArray(vtkDoubleArray *oldArr, vtkDoubleArray *arr);
+  template<class VTKARRAY>
+  static VTKARRAY *Operate2CompoT(VTKARRAY *oldArr);
+  template<class VTKARRAY>
+  static VTKARRAY *OperateMoreThan3CompoT(VTKARRAY *oldArr);
+  static void UpdateInformationOfArray(vtkDataArray *oldArr, vtkDataArray *arr);
 };
 
 #endif
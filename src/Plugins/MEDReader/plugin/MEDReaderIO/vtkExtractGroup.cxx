@@ -26,6 +26,8 @@
 
 #include "vtkAdjacentVertexIterator.h"
 #include "vtkAOSDataArrayTemplate.h"
+#include "vtkArrayDispatch.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkIntArray.h"
 #include "vtkLongArray.h"
 #ifdef WIN32
@@ -57,20 +59,74 @@
 #include "vtkCharArray.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
 #include "vtkDemandDrivenPipeline.h"
+#include "vtkSmartPointer.h"
 #include "vtkDataObjectTreeIterator.h"
-#include "vtkThreshold.h"
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkMultiBlockDataGroupFilter.h"
 #include "vtkCompositeDataToUnstructuredGridFilter.h"
 #include "vtkInformationDataObjectMetaDataKey.h"
 
 #include <map>
 #include <deque>
+#include <algorithm>
 
 vtkStandardNewMacro(vtkExtractGroup)
 
+/*!
+ * Extraction of the cells kept by a selection mask : topology and points of the output, and ids in the input of its cells and points.
+ * It only depends on the mesh, so that the output of another time step on the same mesh is obtained by gathering the arrays.
+ */
+class ExtractGroupMaskExtraction
+{
+public:
+  ExtractGroupMaskExtraction():_on_points(false) { }
+  vtkUnstructuredGrid *buildOutput(vtkDataSet *input) const;
+public:
+  vtkSmartPointer<vtkUnstructuredGrid> _skeleton;
+  std::vector<vtkIdType> _cell_ids;
+  std::vector<vtkIdType> _point_ids;
+  bool _on_points;
+};
+
+/*!
+ * What the extraction depends on, apart from the values of the fields. Only vtkUnstructuredGrid inputs are cached : as in
+ * vtkStaticDataSetSurfaceFilter, the mesh is recognized by its mesh MTime, that does not change when only fields do.
+ */
+class ExtractGroupMeshState
+{
+public:
+  ExtractGroupMeshState():_mesh_mtime(0),_points(0),_cells(0),_fam_cells(0),_fam_nodes(0),_fam_cells_mtime(0),_fam_nodes_mtime(0),_inside_out(0) { }
+  ExtractGroupMeshState(vtkDataSet *input, const std::set<int>& idsToKeep, int insideOut);
+  bool isCacheable() const { return _points!=0; }
+  bool operator==(const ExtractGroupMeshState& other) const;
+private:
+  vtkMTimeType _mesh_mtime;
+  const vtkObject *_points;
+  const vtkObject *_cells;
+  const vtkObject *_fam_cells;
+  const vtkObject *_fam_nodes;
+  vtkMTimeType _fam_cells_mtime;
+  vtkMTimeType _fam_nodes_mtime;
+  std::set<int> _ids_to_keep;
+  int _inside_out;
+};
+
 class vtkExtractGroup::vtkExtractGroupInternal : public ExtractGroupInternal
 {
+public:
+  bool isCacheUpToDate(const ExtractGroupMeshState& state) const { return state.isCacheable() && state==_cached_state; }
+  void setCache(const ExtractGroupMeshState& state, std::vector<ExtractGroupMaskExtraction>& blocks) { _cached_state=state; _cached_blocks.swap(blocks); }
+  void buildOutputFromCache(vtkDataSet *input, vtkMultiBlockDataSet *output) const;
+private:
+  ExtractGroupMeshState _cached_state;
+  std::vector<ExtractGroupMaskExtraction> _cached_blocks;
 };
 
 ////////////////////
@@ -130,71 +186,349 @@ void vtkExtractGroup::SetSIL(vtkMutableDirectedGraph *mdg)
   this->SIL=mdg;
 }
 
-template<class CellPointExtractor>
-vtkDataSet *FilterFamilies(vtkSmartPointer<vtkThreshold>& thres,
-                           vtkDataSet *input, const std::set<int>& idsToKeep, bool insideOut, const char *arrNameOfFamilyField,
-                           const char *associationForThreshold, bool& catchAll, bool& catchSmth)
-{
-  const int VTK_DATA_ARRAY_DELETE=vtkAOSDataArrayTemplate<double>::VTK_DATA_ARRAY_DELETE;
-  const char ZE_SELECTION_ARR_NAME[]="@@ZeSelection@@";
-  vtkDataSet *output(input->NewInstance());
-  output->ShallowCopy(input);
-  thres->SetInputData(output);
-  //vtkDataSetAttributes *dscIn(input->GetCellData()),*dscIn2(input->GetPointData()); // todo: unused
-  //vtkDataSetAttributes *dscOut(output->GetCellData()),*dscOut2(output->GetPointData()); // todo: unused
-  //
-  double vMin(insideOut==0?1.:0.),vMax(insideOut==0?2.:1.);
-  thres->ThresholdBetween(vMin,vMax);
-  // OK for the output
+/*!
+ * Copies in parallel the tuples \a srcIds of \a src into \a dst, already sized to the number of ids. Typed on the concrete arrays,
+ * so the values are copied without any virtual call.
+ */
+template<class SrcArrayT, class DstArrayT>
+class ExtractGroupCopyTuplesFunctor
+{
+public:
+  ExtractGroupCopyTuplesFunctor(SrcArrayT *src, DstArrayT *dst, const vtkIdType *srcIds):_src(src),_dst(dst),_src_ids(srcIds),_nb_of_compo(src->GetNumberOfComponents()) { }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkDataArrayAccessor<SrcArrayT> src(_src);
+    vtkDataArrayAccessor<DstArrayT> dst(_dst);
+    for(vtkIdType i=begin;i<end;i++)
+      for(int j=0;j<_nb_of_compo;j++)
+        dst.Set(i,j,src.Get(_src_ids[i],j));
+  }
+private:
+  SrcArrayT *_src;
+  DstArrayT *_dst;
+  const vtkIdType *_src_ids;
+  int _nb_of_compo;
+};
+
+/*!
+ * vtkArrayDispatch worker instantiating ExtractGroupCopyTuplesFunctor on the concrete types of the arrays.
+ */
+class ExtractGroupCopyTuplesWorker
+{
+public:
+  ExtractGroupCopyTuplesWorker(const vtkIdType *srcIds, vtkIdType nbOfTuples):_src_ids(srcIds),_nb_of_tuples(nbOfTuples) { }
+  template<class SrcArrayT, class DstArrayT>
+  void operator()(SrcArrayT *src, DstArrayT *dst)
+  {
+    ExtractGroupCopyTuplesFunctor<SrcArrayT,DstArrayT> functor(src,dst,_src_ids);
+    vtkSMPTools::For(0,_nb_of_tuples,functor);
+  }
+private:
+  const vtkIdType *_src_ids;
+  vtkIdType _nb_of_tuples;
+};
+
+/*!
+ * Copies the tuples \a srcIds of \a src into \a dst, already sized to the number of ids. Data arrays go through the typed parallel copy,
+ * the other ones (string, variant...) and the data arrays unknown to vtkArrayDispatch through a single GetTuples call.
+ */
+static void CopyTuplesOfIds(vtkAbstractArray *src, vtkAbstractArray *dst, const std::vector<vtkIdType>& srcIds)
+{
+  vtkIdType nbOfTuples(srcIds.size());
+  vtkDataArray *srcDa(vtkDataArray::SafeDownCast(src)),*dstDa(vtkDataArray::SafeDownCast(dst));
+  ExtractGroupCopyTuplesWorker worker(srcIds.empty()?0:&srcIds[0],nbOfTuples);
+  if(srcDa && dstDa && vtkArrayDispatch::Dispatch2SameValueType::Execute(srcDa,dstDa,worker))
+    return ;
+  vtkSmartPointer<vtkIdList> ids(vtkSmartPointer<vtkIdList>::New());
+  ids->SetNumberOfIds(nbOfTuples);
+  std::copy(srcIds.begin(),srcIds.end(),ids->GetPointer(0));
+  src->GetTuples(ids,dst);
+}
+
+/*!
+ * Points of a dataset which is not a vtkPointSet, converted into a float array as vtkThreshold does.
+ */
+class ExtractGroupCopyPointsFunctor
+{
+public:
+  ExtractGroupCopyPointsFunctor(vtkDataSet *src, vtkPoints *dst, const vtkIdType *srcIds):_src(src),_dst(dst),_src_ids(srcIds) { }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double pt[3];
+    for(vtkIdType i=begin;i<end;i++)
+      {
+        _src->GetPoint(_src_ids[i],pt);
+        _dst->SetPoint(i,pt);
+      }
+  }
+private:
+  vtkDataSet *_src;
+  vtkPoints *_dst;
+  const vtkIdType *_src_ids;
+};
+
+/*!
+ * Evaluates in parallel the cells kept by a selection mask defined on cells or on points. \a _nb_of_pts_of_kept is set to the number of points
+ * of each kept cell and to -1 for the others. As in vtkThreshold, a cell selected on points needs all its points selected, and cells without
+ * points are never kept.
+ */
+class ExtractGroupKeptCellsFunctor
+{
+public:
+  ExtractGroupKeptCellsFunctor(vtkDataSet *ds, const char *mask, bool onPoints, bool insideOut, vtkIdType *nbOfPtsOfKept):
+    _ds(ds),_mask(mask),_on_points(onPoints),_inside_out(insideOut),_nb_of_pts_of_kept(nbOfPtsOfKept) { }
+  void Initialize() { }
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList *ids(_ids.Local());
+    for(vtkIdType cellId=begin;cellId<end;cellId++)
+      {
+        _ds->GetCellPoints(cellId,ids);
+        vtkIdType nbOfPts(ids->GetNumberOfIds());
+        bool keep(true);
+        if(_on_points)
+          for(vtkIdType i=0;i<nbOfPts && keep;i++)
+            keep=isKept(ids->GetId(i));
+        else
+          keep=isKept(cellId);
+        _nb_of_pts_of_kept[cellId]=keep && nbOfPts>0?nbOfPts:-1;
+      }
+  }
+  void Reduce() { }
+private:
+  bool isKept(vtkIdType id) const { return (_mask[id]!=0)!=_inside_out; }
+private:
+  vtkDataSet *_ds;
+  const char *_mask;
+  bool _on_points;
+  bool _inside_out;
+  vtkIdType *_nb_of_pts_of_kept;
+  vtkSMPThreadLocalObject<vtkIdList> _ids;
+};
+
+/*!
+ * Copies the tuples \a srcIds of all the arrays of \a src into \a dst, keeping their attribute types. If \a dropScalars the active scalars
+ * of \a src are copied as a regular array, as vtkThreshold does for the attributes holding the selection.
+ */
+static void CopyAttributesOfIds(vtkDataSetAttributes *src, vtkDataSetAttributes *dst, const std::vector<vtkIdType>& srcIds, bool dropScalars)
+{
+  vtkIdType nbOfTuples(srcIds.size());
+  for(int i=0;i<src->GetNumberOfArrays();i++)
+    {
+      vtkAbstractArray *srcArr(src->GetAbstractArray(i));
+      vtkAbstractArray *dstArr(srcArr->NewInstance());
+      dstArr->SetName(srcArr->GetName());
+      dstArr->SetNumberOfComponents(srcArr->GetNumberOfComponents());
+      dstArr->CopyComponentNames(srcArr);
+      if(srcArr->HasInformation())
+        dstArr->CopyInformation(srcArr->GetInformation(),1);
+      dstArr->SetNumberOfTuples(nbOfTuples);
+      CopyTuplesOfIds(srcArr,dstArr,srcIds);
+      int idx(dst->AddArray(dstArr)),attr(src->IsArrayAnAttribute(i));
+      dstArr->Delete();
+      if(attr>=0 && !(dropScalars && attr==vtkDataSetAttributes::SCALARS))
+        dst->SetActiveAttribute(idx,attr);
+    }
+}
+
+/*!
+ * Gathers the arrays of \a input on the cells and points of the extraction, the topology being shared with \a _skeleton.
+ */
+vtkUnstructuredGrid *ExtractGroupMaskExtraction::buildOutput(vtkDataSet *input) const
+{
+  vtkUnstructuredGrid *ret(vtkUnstructuredGrid::New());
+  ret->CopyStructure(_skeleton);
+  CopyAttributesOfIds(input->GetCellData(),ret->GetCellData(),_cell_ids,!_on_points);
+  CopyAttributesOfIds(input->GetPointData(),ret->GetPointData(),_point_ids,_on_points);
+  ret->GetFieldData()->ShallowCopy(input->GetFieldData());
+  return ret;
+}
+
+ExtractGroupMeshState::ExtractGroupMeshState(vtkDataSet *input, const std::set<int>& idsToKeep, int insideOut):_mesh_mtime(0),_points(0),_cells(0),
+                                                                                                                _fam_cells(0),_fam_nodes(0),_fam_cells_mtime(0),_fam_nodes_mtime(0),
+                                                                                                                _ids_to_keep(idsToKeep),_inside_out(insideOut)
+{
+  vtkUnstructuredGrid *ug(vtkUnstructuredGrid::SafeDownCast(input));
+  if(!ug || !ug->GetPoints())
+    return ;
+  _mesh_mtime=ug->GetMeshMTime();
+  _points=ug->GetPoints();
+  _cells=ug->GetCells();
+  vtkDataArray *famCells(input->GetCellData()->GetArray(MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_CELL_NAME));
+  vtkDataArray *famNodes(input->GetPointData()->GetArray(MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME));
+  if(famCells)
+    { _fam_cells=famCells; _fam_cells_mtime=famCells->GetMTime(); }
+  if(famNodes)
+    { _fam_nodes=famNodes; _fam_nodes_mtime=famNodes->GetMTime(); }
+}
+
+bool ExtractGroupMeshState::operator==(const ExtractGroupMeshState& other) const
+{
+  return _mesh_mtime==other._mesh_mtime && _points==other._points && _cells==other._cells && _fam_cells==other._fam_cells && _fam_nodes==other._fam_nodes &&
+    _fam_cells_mtime==other._fam_cells_mtime && _fam_nodes_mtime==other._fam_nodes_mtime && _inside_out==other._inside_out && _ids_to_keep==other._ids_to_keep;
+}
+
+void vtkExtractGroup::vtkExtractGroupInternal::buildOutputFromCache(vtkDataSet *input, vtkMultiBlockDataSet *output) const
+{
+  for(std::size_t i=0;i<_cached_blocks.size();i++)
+    {
+      vtkUnstructuredGrid *ds(_cached_blocks[i].buildOutput(input));
+      output->SetBlock((unsigned int)i,ds);
+      ds->Delete();
+    }
+}
+
+/*!
+ * Extracts the cells of \a input kept by \a mask, defined on cells or on points depending on \a onPoints. The result is the one vtkThreshold
+ * gives on \a mask in [1,2] (or [0,1] if \a insideOut) : same cells in the same order, points numbered in the order of their first use by the
+ * kept cells. Only the topology and the points are built here, the arrays are gathered by ExtractGroupMaskExtraction::buildOutput.
+ * The selection of the cells and the copy of the points are multithreaded.
+ */
+static void ExtractCellsOfMask(vtkDataSet *input, const std::vector<char>& mask, bool onPoints, bool insideOut, ExtractGroupMaskExtraction& ret)
+{
+  vtkIdType nbOfCells(input->GetNumberOfCells()),nbOfPts(input->GetNumberOfPoints());
+  vtkUnstructuredGrid *ug(vtkUnstructuredGrid::SafeDownCast(input));
+  vtkSmartPointer<vtkIdList> ids(vtkSmartPointer<vtkIdList>::New());
+  std::vector<vtkIdType> nbOfPtsOfKept(nbOfCells);
+  if(nbOfCells>0)
+    {// first calls from a single thread to make GetCellPoints/GetCellType/GetPoint thread safe
+      input->GetCellPoints(0,ids);
+      input->GetCellType(0);
+      if(nbOfPts>0)
+        {
+          double pt[3];
+          input->GetPoint(0,pt);
+        }
+      ExtractGroupKeptCellsFunctor functor(input,&mask[0],onPoints,insideOut,&nbOfPtsOfKept[0]);
+      vtkSMPTools::For(0,nbOfCells,functor);
+    }
+  // cells and points of the output, points being numbered in the order of their first use
+  std::vector<vtkIdType> cellIds,pointIds,pointMap(nbOfPts,-1);
+  vtkIdType connLgth(0);
+  for(vtkIdType cellId=0;cellId<nbOfCells;cellId++)
+    if(nbOfPtsOfKept[cellId]>=0)
+      {
+        cellIds.push_back(cellId);
+        connLgth+=nbOfPtsOfKept[cellId]+1;
+      }
+  vtkIdType nbOfCellsOut(cellIds.size());
+  vtkSmartPointer<vtkUnsignedCharArray> cellTypes(vtkSmartPointer<vtkUnsignedCharArray>::New());
+  cellTypes->SetNumberOfTuples(nbOfCellsOut);
+  vtkSmartPointer<vtkIdTypeArray> cellLocations(vtkSmartPointer<vtkIdTypeArray>::New()),conn(vtkSmartPointer<vtkIdTypeArray>::New());
+  cellLocations->SetNumberOfTuples(nbOfCellsOut);
+  conn->SetNumberOfTuples(connLgth);
+  vtkSmartPointer<vtkIdTypeArray> faceLocations,faces;
+  vtkIdType *connPt(conn->GetPointer(0)),*cellLocPt(cellLocations->GetPointer(0)),curLoc(0);
+  unsigned char *cellTypePt(cellTypes->GetPointer(0));
+  vtkSmartPointer<vtkIdList> faceStream(vtkSmartPointer<vtkIdList>::New());
+  for(vtkIdType i=0;i<nbOfCellsOut;i++)
+    {
+      vtkIdType cellId(cellIds[i]);
+      input->GetCellPoints(cellId,ids);
+      vtkIdType nbOfPtsOfCell(ids->GetNumberOfIds());
+      for(vtkIdType j=0;j<nbOfPtsOfCell;j++)
+        {
+          vtkIdType ptId(ids->GetId(j));
+          if(pointMap[ptId]<0)
+            {
+              pointMap[ptId]=pointIds.size();
+              pointIds.push_back(ptId);
+            }
+        }
+      cellTypePt[i]=(unsigned char)input->GetCellType(cellId);
+      cellLocPt[i]=curLoc;
+      connPt[curLoc++]=nbOfPtsOfCell;
+      if(ug && cellTypePt[i]==VTK_POLYHEDRON)
+        {// the face stream is renumbered, and vtkUnstructuredGrid stores the points of a polyhedron sorted
+          if(!faces)
+            {
+              faces=vtkSmartPointer<vtkIdTypeArray>::New();
+              faceLocations=vtkSmartPointer<vtkIdTypeArray>::New();
+              faceLocations->SetNumberOfTuples(nbOfCellsOut);
+              std::fill(faceLocations->GetPointer(0),faceLocations->GetPointer(0)+nbOfCellsOut,-1);
+            }
+          faceLocations->SetValue(i,faces->GetNumberOfTuples());
+          ug->GetFaceStream(cellId,faceStream);
+          vtkIdType *fs(faceStream->GetPointer(0)),nbOfFaces(*fs++);
+          faces->InsertNextValue(nbOfFaces);
+          std::set<vtkIdType> cellPts;
+          for(vtkIdType f=0;f<nbOfFaces;f++)
+            {
+              vtkIdType nbOfPtsOfFace(*fs++);
+              faces->InsertNextValue(nbOfPtsOfFace);
+              for(vtkIdType j=0;j<nbOfPtsOfFace;j++,fs++)
+                {
+                  faces->InsertNextValue(pointMap[*fs]);
+                  cellPts.insert(pointMap[*fs]);
+                }
+            }
+          connPt[curLoc-1]=cellPts.size();
+          curLoc=std::copy(cellPts.begin(),cellPts.end(),connPt+curLoc)-connPt;
+        }
+      else
+        for(vtkIdType j=0;j<nbOfPtsOfCell;j++)
+          connPt[curLoc++]=pointMap[ids->GetId(j)];
+    }
+  conn->SetNumberOfTuples(curLoc);
   //
+  vtkSmartPointer<vtkUnstructuredGrid> skeleton(vtkSmartPointer<vtkUnstructuredGrid>::New());
+  vtkSmartPointer<vtkCellArray> cells(vtkSmartPointer<vtkCellArray>::New());
+  cells->SetCells(nbOfCellsOut,conn);
+  if(faces)
+    skeleton->SetCells(cellTypes,cellLocations,cells,faceLocations,faces);
+  else
+    skeleton->SetCells(cellTypes,cellLocations,cells);
+  vtkIdType nbOfPtsOut(pointIds.size());
+  vtkSmartPointer<vtkPoints> pts(vtkSmartPointer<vtkPoints>::New());
+  vtkPointSet *ps(vtkPointSet::SafeDownCast(input));
+  if(ps && ps->GetPoints())
+    {
+      vtkDataArray *srcCoords(ps->GetPoints()->GetData());
+      vtkDataArray *coords(srcCoords->NewInstance());
+      coords->SetNumberOfComponents(3);
+      coords->SetNumberOfTuples(nbOfPtsOut);
+      CopyTuplesOfIds(srcCoords,coords,pointIds);
+      pts->SetData(coords);
+      coords->Delete();
+    }
+  else
+    {
+      pts->SetDataType(VTK_FLOAT);
+      pts->SetNumberOfPoints(nbOfPtsOut);
+      ExtractGroupCopyPointsFunctor functor(input,pts,pointIds.empty()?0:&pointIds[0]);
+      vtkSMPTools::For(0,nbOfPtsOut,functor);
+    }
+  skeleton->SetPoints(pts);
+  ret._skeleton=skeleton;
+  ret._cell_ids.swap(cellIds);
+  ret._point_ids.swap(pointIds);
+  ret._on_points=onPoints;
+}
+
+/*!
+ * \return false if \a input has no family array \a arrNameOfFamilyField. \a ret is not touched in this case.
+ */
+template<class CellPointExtractor>
+bool FilterFamilies(vtkDataSet *input, const std::set<int>& idsToKeep, bool insideOut, const char *arrNameOfFamilyField,
+                    ExtractGroupMaskExtraction& ret, bool& catchAll, bool& catchSmth)
+{
   CellPointExtractor cpe2(input);
   vtkDataArray *da(cpe2.Get()->GetScalars(arrNameOfFamilyField));
   if(!da)
-    return 0;
+    return false;
   std::string daName(da->GetName());
   typedef MEDFileVTKTraits<MEDCoupling::mcIdType>::VtkType vtkMCIdTypeArray;
   vtkMCIdTypeArray *dai(vtkMCIdTypeArray::SafeDownCast(da));
   if(daName!=arrNameOfFamilyField || !dai)
-    return 0;
+    return false;
   //
-  int nbOfTuples(dai->GetNumberOfTuples());
-  vtkCharArray *zeSelection(vtkCharArray::New());
-  zeSelection->SetName(ZE_SELECTION_ARR_NAME);
-  zeSelection->SetNumberOfComponents(1);
-  char *pt(new char[nbOfTuples]);
-  zeSelection->SetArray(pt,nbOfTuples,0,VTK_DATA_ARRAY_DELETE);
+  vtkIdType nbOfTuples(dai->GetNumberOfTuples());
+  std::vector<char> mask(nbOfTuples+1);
   const MEDCoupling::mcIdType *inPtr(dai->GetPointer(0));
-  std::fill(pt,pt+nbOfTuples,0);
-  catchAll=true; catchSmth=false;
-  std::vector<bool> pt2(nbOfTuples,false);
-  for(std::set<int>::const_iterator it=idsToKeep.begin();it!=idsToKeep.end();it++)
-    {
-      bool catchFid(false);
-      for(int i=0;i<nbOfTuples;i++)
-        if(inPtr[i]==*it)
-          { pt2[i]=true; catchFid=true; }
-      if(!catchFid)
-        catchAll=false;
-      else
-        catchSmth=true;
-    }
-  for(int ii=0;ii<nbOfTuples;ii++)
-    if(pt2[ii])
-      pt[ii]=2;
-  CellPointExtractor cpe3(output);
-  int idx(cpe3.Get()->AddArray(zeSelection));
-  cpe3.Get()->SetActiveAttribute(idx,vtkDataSetAttributes::SCALARS);
-  cpe3.Get()->CopyScalarsOff();
-  zeSelection->Delete();
-  //
-  thres->SetInputArrayToProcess(idx,0,0,associationForThreshold,ZE_SELECTION_ARR_NAME);
-  thres->Update();
-  vtkUnstructuredGrid *zeComputedOutput(thres->GetOutput());
-  CellPointExtractor cpe(zeComputedOutput);
-  cpe.Get()->RemoveArray(idx);
-  output->Delete();
-  zeComputedOutput->Register(0);
-  return zeComputedOutput;
+  ExtractGroupFamilySelector selector(idsToKeep);
+  selector.select(inPtr,nbOfTuples,&mask[0],2,catchAll,catchSmth);
+  ExtractCellsOfMask(input,mask,CellPointExtractor::ON_POINTS,insideOut,ret);
+  return true;
 }
 
 class CellExtractor
@@ -202,6 +536,8 @@ class CellExtractor
 public:
   CellExtractor(vtkDataSet *ds):_ds(ds) { }
   vtkDataSetAttributes *Get() { return _ds->GetCellData(); }
+public:
+  static const bool ON_POINTS=false;
 private:
   vtkDataSet *_ds;
 };
@@ -211,6 +547,8 @@ class PointExtractor
 public:
   PointExtractor(vtkDataSet *ds):_ds(ds) { }
   vtkDataSetAttributes *Get() { return _ds->GetPointData(); }
+public:
+  static const bool ON_POINTS=true;
 private:
   vtkDataSet *_ds;
 };
@@ -238,68 +576,44 @@ int vtkExtractGroup::RequestData(vtkInformation * /*request*/, vtkInformationVec
       vtkMultiBlockDataSet *output(vtkMultiBlockDataSet::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT())));
       std::set<int> idsToKeep(this->Internal->getIdsToKeep());
       this->Internal->clearSelection();
+      // on a mesh already extracted (another time step) only the arrays are gathered
+      ExtractGroupMeshState state(input,idsToKeep,this->InsideOut);
+      if(this->Internal->isCacheUpToDate(state))
+        {
+          this->Internal->buildOutputFromCache(input,output);
+          return 1;
+        }
       // first shrink the input
       bool catchAll,catchSmth;
-      vtkSmartPointer<vtkThreshold> thres1(vtkSmartPointer<vtkThreshold>::New()),thres2(vtkSmartPointer<vtkThreshold>::New());
-      vtkDataSet *tryOnCell(FilterFamilies<CellExtractor>(thres1,input,idsToKeep,this->InsideOut,
-                                                          MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_CELL_NAME,"vtkDataObject::FIELD_ASSOCIATION_CELLS",catchAll,catchSmth));
-      if(tryOnCell)
+      std::vector<ExtractGroupMaskExtraction> blocks(1);
+      if(FilterFamilies<CellExtractor>(input,idsToKeep,this->InsideOut,MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_CELL_NAME,blocks[0],catchAll,catchSmth))
         {
-          if(catchAll)
-            {
-              output->SetBlock(0,tryOnCell);
-              tryOnCell->Delete();//
-              return 1;
-            }
-          else
+          if(!catchAll)
             {
               if(catchSmth)
                 {
-                  vtkDataSet *tryOnNode(FilterFamilies<PointExtractor>(thres2,input,idsToKeep,this->InsideOut,
-                                                                       MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME,"vtkDataObject::FIELD_ASSOCIATION_POINTS",catchAll,catchSmth));
-                  if(tryOnNode && catchSmth)
-                    {
-                      output->SetBlock(0,tryOnCell);
-                      output->SetBlock(1,tryOnNode);
-                      tryOnCell->Delete();
-                      tryOnNode->Delete();
-                      return 1;
-                    }
-                  else
-                    {
-                      if(tryOnNode)
-                        tryOnNode->Delete();
-                      output->SetBlock(0,tryOnCell);
-                      tryOnCell->Delete();
-                      return 1;
-                    }
+                  blocks.resize(2);
+                  if(!FilterFamilies<PointExtractor>(input,idsToKeep,this->InsideOut,MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME,blocks[1],catchAll,catchSmth) || !catchSmth)
+                    blocks.pop_back();
                 }
               else
                 {
-                  vtkDataSet *tryOnNode(FilterFamilies<PointExtractor>(thres1,input,idsToKeep,this->InsideOut,
-                                                                       MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME,"vtkDataObject::FIELD_ASSOCIATION_POINTS",catchAll,catchSmth));
-                  if(tryOnNode)
-                    {
-                      tryOnCell->Delete();
-                      output->SetBlock(0,tryOnNode);
-                      tryOnNode->Delete();
-                      return 1;
-                    }
-                  else
+                  if(!FilterFamilies<PointExtractor>(input,idsToKeep,this->InsideOut,MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME,blocks[0],catchAll,catchSmth))
                     {
-                      output->SetBlock(0,tryOnNode);
-                      tryOnCell->Delete();
+                      output->SetBlock(0,0);
                       return 0;
                     }
                 }
             }
+          this->Internal->setCache(state,blocks);
+          this->Internal->buildOutputFromCache(input,output);
+          return 1;
         }
       else
         {
-          vtkDataSet *tryOnNode(FilterFamilies<PointExtractor>(thres1,input,idsToKeep,this->InsideOut,
-                                                               MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME,"vtkDataObject::FIELD_ASSOCIATION_POINTS",catchAll,catchSmth));
-          if(tryOnNode)
+          if(FilterFamilies<PointExtractor>(input,idsToKeep,this->InsideOut,MEDFileFieldRepresentationLeavesArrays::FAMILY_ID_NODE_NAME,blocks[0],catchAll,catchSmth))
             {
+              vtkUnstructuredGrid *tryOnNode(blocks[0].buildOutput(input));
               output->ShallowCopy(tryOnNode);
               tryOnNode->Delete();//
               return 1;
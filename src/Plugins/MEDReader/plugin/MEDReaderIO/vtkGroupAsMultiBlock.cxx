@@ -43,17 +43,88 @@
 #include <vtkMultiBlockDataSet.h>
 #include <vtkCellCenters.h>
 #include <vtkGlyphSource2D.h>
+#include <vtkIdList.h>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPThreadLocalObject.h>
+
+#include <set>
 
 class vtkGroupAsMultiBlockInternal : public ExtractGroupInternal
 {
 };
 
+/*!
+ * Cell ids of each group of \a allGroups, computed in a single pass over the family ids thanks to an index giving the groups lying on each family.
+ * The cell ids of each group are sorted.
+ */
+static std::vector< std::vector<vtkIdType> > BucketCellIdsPerGroup(const mcIdType *famIds, vtkIdType nbOfCells, const std::vector< std::pair<std::string,std::vector<int> > >& allGroups)
+{
+  std::set<int> allFamIds;
+  for(const auto& grp : allGroups)
+    allFamIds.insert(grp.second.begin(),grp.second.end());
+  ExtractGroupFamilySelector famIndex(allFamIds);
+  std::vector< std::vector<int> > groupsOfFam(allFamIds.size());
+  for(std::size_t grpId = 0 ; grpId < allGroups.size() ; ++grpId)
+    for(const auto& famId : allGroups[grpId].second)
+    {
+      std::vector<int>& grps(groupsOfFam[famIndex.indexOf(famId)]);
+      if( grps.empty() || grps.back() != (int)grpId )
+        grps.push_back((int)grpId);
+    }
+  std::vector< std::vector<vtkIdType> > ret(allGroups.size());
+  for(vtkIdType cellId = 0 ; cellId < nbOfCells ; ++cellId)
+  {
+    int pos(famIndex.indexOf(famIds[cellId]));
+    if( pos >= 0 )
+      for(const auto& grpId : groupsOfFam[pos])
+        ret[grpId].push_back(cellId);
+  }
+  return ret;
+}
+
+/*!
+ * Builds the blocks of several groups in parallel, one group after another in each thread.
+ */
+class GroupBlocksBuilder
+{
+public:
+  GroupBlocksBuilder(vtkUnstructuredGrid *ds, const std::vector< std::vector<vtkIdType> >& cellIdsPerGroup, bool compactPoints, std::vector< vtkSmartPointer<vtkUnstructuredGrid> >& blocks):_ds(ds),_cell_ids_per_group(cellIdsPerGroup),_compact_points(compactPoints),_blocks(blocks) { }
+  void Initialize() { }
+  void operator()(vtkIdType first, vtkIdType last)
+  {
+    for(vtkIdType grpId = first ; grpId < last ; ++grpId)
+    {
+      const std::vector<vtkIdType>& cellIds(_cell_ids_per_group[grpId]);
+      _blocks[grpId] = vtkUgSelectCellIds::SelectCellIds(_ds,cellIds.data(),cellIds.size(),_compact_points,_pt_ids.Local(),_face_stream.Local(),_point_map.Local());
+    }
+  }
+  void Reduce() { }
+private:
+  vtkUnstructuredGrid *_ds;
+  const std::vector< std::vector<vtkIdType> >& _cell_ids_per_group;
+  bool _compact_points;
+  std::vector< vtkSmartPointer<vtkUnstructuredGrid> >& _blocks;
+  vtkSMPThreadLocalObject<vtkIdList> _pt_ids;
+  vtkSMPThreadLocalObject<vtkIdList> _face_stream;
+  vtkSMPThreadLocal< std::vector<vtkIdType> > _point_map;
+};
+
 vtkStandardNewMacro(vtkGroupAsMultiBlock)
 
-vtkGroupAsMultiBlock::vtkGroupAsMultiBlock():Internal(new ExtractGroupInternal)
+vtkGroupAsMultiBlock::vtkGroupAsMultiBlock():Internal(new ExtractGroupInternal),CompactPoints(false)
 {
 }
 
+void vtkGroupAsMultiBlock::SetCompactPoints(int val)
+{
+  if(this->CompactPoints!=(val!=0))
+  {
+    this->CompactPoints=(val!=0);
+    this->Modified();
+  }
+}
+
 vtkGroupAsMultiBlock::~vtkGroupAsMultiBlock()
 {
   delete this->Internal;
@@ -115,26 +186,13 @@ int vtkGroupAsMultiBlock::RequestData(vtkInformation *vtkNotUsed(request), vtkIn
   // Let's go !
   vtkIdType inputNbCell(famIdsArr->GetNumberOfTuples());
   std::vector< std::pair<std::string,std::vector<int> > > allGroups(this->Internal->getAllGroups());
+  std::vector< std::vector<vtkIdType> > cellIdsPerGroup(BucketCellIdsPerGroup(famIdsArr->GetPointer(0),inputNbCell,allGroups));
+  std::vector< vtkSmartPointer<vtkUnstructuredGrid> > blocks(allGroups.size());
+  GroupBlocksBuilder builder(inputc,cellIdsPerGroup,this->CompactPoints,blocks);
+  vtkSMPTools::For(0,(vtkIdType)allGroups.size(),1,builder);
   output->SetNumberOfBlocks(allGroups.size());
   int blockId(0);
-  for(const auto& grp : allGroups)
-  {
-    std::vector<vtkIdType> ids;
-    // iterate on all families on current group grp
-    for(const auto& famId : grp.second)
-    {// for each family of group grp locate cells in input lying on that group
-      vtkIdType pos(0);
-      std::for_each(famIdsArr->GetPointer(0),famIdsArr->GetPointer(inputNbCell),[&pos,&ids,famId](vtkIdType curFamId) { if(curFamId == famId) { ids.push_back(pos); } pos++; });
-    }
-    std::sort(ids.begin(),ids.end());
-    vtkNew<vtkIdTypeArray> idsVTK;
-    idsVTK->SetNumberOfComponents(1); idsVTK->SetNumberOfTuples(ids.size());
-    std::copy(ids.begin(),ids.end(),idsVTK->GetPointer(0));
-    vtkNew<vtkUgSelectCellIds> cellSelector;
-    cellSelector->SetIds(idsVTK);
-    cellSelector->SetInputData(inputc);
-    cellSelector->Update();
-    output->SetBlock(blockId++,cellSelector->GetOutput());
-  }
+  for(const auto& block : blocks)
+    output->SetBlock(blockId++,block);
   return 1;
 }
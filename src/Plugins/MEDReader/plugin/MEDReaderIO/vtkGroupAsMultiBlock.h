@@ -29,6 +29,9 @@ class vtkGroupAsMultiBlock : public vtkMultiBlockDataSetAlgorithm
 public:
     static vtkGroupAsMultiBlock *New();
     vtkTypeMacro(vtkGroupAsMultiBlock, vtkMultiBlockDataSetAlgorithm)
+    //! If set, each block only keeps the points of its cells instead of sharing all the points of the input. Off by default.
+    void SetCompactPoints(int val);
+    int GetCompactPoints() const { return this->CompactPoints; }
 protected:
     vtkGroupAsMultiBlock();
     ~vtkGroupAsMultiBlock();
@@ -36,4 +39,5 @@ protected:
     int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 private:
     ExtractGroupInternal *Internal;
+    bool CompactPoints;
 };
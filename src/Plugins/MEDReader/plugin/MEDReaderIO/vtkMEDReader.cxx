@@ -19,7 +19,6 @@
 // Author : Anthony Geay
 
 #include "vtkMEDReader.h"
-#include "vtkGenerateVectors.h"
 #include "MEDUtilities.hxx"
 
 #include "vtkCellArray.h"
@@ -29,6 +28,7 @@
 #include "vtkDataArraySelection.h"
 #include "vtkDoubleArray.h"
 #include "vtkExecutive.h"
+#include "vtkFieldData.h"
 #include "vtkInformation.h"
 #include "vtkInformationDataObjectMetaDataKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -38,6 +38,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiTimeStepAlgorithm.h"
 #include "vtkMutableDirectedGraph.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkQuadratureSchemeDefinition.h"
@@ -50,51 +51,263 @@
 
 #ifdef MEDREADER_USE_MPI
 #include "vtkMultiProcessController.h"
-#include "vtkPUnstructuredGridGhostCellsGenerator.h"
+#include "vtkMEDReaderGhostCellsGenerator.h"
 #endif
 
 #include "MEDFileFieldRepresentationTree.hxx"
 
 #include <map>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 class vtkMEDReader::vtkMEDReaderInternal
 {
 
 public:
-  vtkMEDReaderInternal(vtkMEDReader *master):TK(0),IsStdOrMode(false),GenerateVect(false),SIL(0),LastLev0(-1),GCGCP(true)
+  vtkMEDReaderInternal(vtkMEDReader *master):TK(0),IsStdOrMode(false),SIL(0),LastLev0(-1),GCGCP(true),UseIndex(false),
+                                             Prefetch(false),PrefetchInterrupt(false),PrefetchTime(0.),PrefetchedDS(0),PrefetchFailed(false),NumberOfPrefetchHits(0),LastReqTS(0.),HasLastReqTS(false),
+                                             SyncedStructureStamp(-1),SILStructureStamp(-1),IncrementalReload(false),TimingsInFieldData(false)
   {
   }
 
   ~vtkMEDReaderInternal()
   {
+    this->StopPrefetch();
     if(this->SIL)
       this->SIL->Delete();
   }
+
+  //! Interrupts the background build if any and forgets its result. To be called before any access to Tree or TK.
+  void StopPrefetch()
+  {
+    this->PrefetchInterrupt=true;
+    this->JoinPrefetch();
+    this->DiscardPrefetched();
+  }
+
+  void JoinPrefetch()
+  {
+    if(this->PrefetchThread.joinable())
+      this->PrefetchThread.join();
+    this->PrefetchInterrupt=false;
+  }
+
+  void DiscardPrefetched()
+  {
+    if(this->PrefetchedDS)
+      this->PrefetchedDS->Delete();
+    this->PrefetchedDS=0;
+    this->PrefetchedInfo=ExportedTinyInfo();
+    this->PrefetchFailed=false;
+  }
+
+  /*!
+   * Waits for the background build if it targets \a reqTS, interrupts it otherwise. After this call the tree can be accessed.
+   */
+  void SyncPrefetch(double reqTS)
+  {
+    if(reqTS!=this->PrefetchTime)
+      this->StopPrefetch();
+    else
+      this->JoinPrefetch();
+  }
+
+  /*!
+   * Returns the dataset built in background if it matches \a reqTS (0 otherwise). The returned dataset is owned by the caller.
+   * 0 is also returned if the background build failed, so that the caller falls back to a synchronous build.
+   */
+  vtkDataSet *TakePrefetched(double reqTS, ExportedTinyInfo *internalInfo)
+  {
+    this->SyncPrefetch(reqTS);
+    if(this->PrefetchFailed)
+      this->DiscardPrefetched();
+    vtkDataSet *ret(this->PrefetchedDS);
+    if(ret)
+      this->NumberOfPrefetchHits++;
+    if(ret && internalInfo)
+      *internalInfo=this->PrefetchedInfo;
+    this->PrefetchedDS=0;
+    this->PrefetchedInfo=ExportedTinyInfo();
+    return ret;
+  }
+
+  /*!
+   * Starts in a background thread the build of the time step \a ts. The tree is not touched by the main thread until JoinPrefetch or StopPrefetch.
+   */
+  void StartPrefetch(double ts)
+  {
+    this->StopPrefetch();
+    this->PrefetchTime=ts;
+    this->PrefetchThread=std::thread([this,ts]()
+      {
+        try
+          {
+            std::string meshName;
+            ExportedTinyInfo ti;
+            vtkDataSet *ds(this->Tree.buildVTKInstance(false,ts,meshName,this->TK,&ti,&this->PrefetchInterrupt));
+            this->PrefetchedDS=ds;
+            this->PrefetchedInfo=ti;
+          }
+        catch(...)
+          {// interrupted or failure. No exception must leave the thread : the failure is reported by the synchronous read.
+            this->PrefetchFailed=true;
+          }
+      });
+  }
+
+  /*!
+   * Pushes to the tree the status of the arrays of FieldSelection. All of them are pushed the first time and each time the structure
+   * of the tree is reloaded. Otherwise only the ones changed by SetFieldsStatus since the last call are pushed.
+   * Arrays unknown by the tree are removed from FieldSelection.
+   * \return true if the status of at least one array has been pushed.
+   */
+  bool SyncFieldSelection()
+  {
+    bool ret(false);
+    if(this->Tree.getStructureStamp()!=this->SyncedStructureStamp)
+      {
+        for(int i=this->FieldSelection->GetNumberOfArrays()-1;i>=0;i--)
+          {
+            try
+              {
+                this->Tree.changeStatusOfAndUpdateToHaveCoherentVTKDataSet(this->Tree.getIdHavingZeName(this->FieldSelection->GetArrayName(i)),
+                                                                           this->FieldSelection->GetArraySetting(i));
+              }
+            catch(INTERP_KERNEL::Exception&)
+              {// Remove the incorrect array
+                this->FieldSelection->RemoveArrayByIndex(i);
+              }
+          }
+        this->FieldStatus.clear();
+        for(int i=0;i<this->FieldSelection->GetNumberOfArrays();i++)
+          this->FieldStatus[this->FieldSelection->GetArrayName(i)]=this->FieldSelection->GetArraySetting(i)!=0;
+        this->SyncedStructureStamp=this->Tree.getStructureStamp();
+        this->PendingFieldChanges.clear();
+        return true;
+      }
+    for(std::set<std::string>::const_iterator it=this->PendingFieldChanges.begin();it!=this->PendingFieldChanges.end();it++)
+      {
+        std::unordered_map<std::string,bool>::iterator it2(this->FieldStatus.find(*it));
+        if(it2==this->FieldStatus.end())
+          continue;
+        try
+          {
+            this->Tree.changeStatusOfAndUpdateToHaveCoherentVTKDataSet(this->Tree.getIdHavingZeName((*it).c_str()),(*it2).second);
+            ret=true;
+          }
+        catch(INTERP_KERNEL::Exception&)
+          {// Remove the incorrect array
+            this->FieldSelection->RemoveArrayByName((*it).c_str());
+            this->FieldStatus.erase(it2);
+          }
+      }
+    this->PendingFieldChanges.clear();
+    return ret;
+  }
+
 public:
   MEDFileFieldRepresentationTree Tree;
   vtkNew<vtkDataArraySelection> FieldSelection;
   vtkNew<vtkDataArraySelection> TimeFlagSelection;
+  // mirror of FieldSelection for constant time lookups : SetFieldsStatus is called for every array at each push of the property.
+  std::unordered_map<std::string,bool> FieldStatus;
+  // names of the arrays which status changed since the last SyncFieldSelection
+  std::set<std::string> PendingFieldChanges;
+  // structure stamp of Tree when FieldSelection has been fully pushed to it
+  int SyncedStructureStamp;
+  // structure stamp of Tree when SIL has been built
+  int SILStructureStamp;
 
   TimeKeeper TK;
   std::string FileName;
   //when false -> std, true -> mode. By default std (false).
   bool IsStdOrMode;
-  //when false -> do nothing. When true cut off or extend to nbOfCompo=3 vector arrays.
-  bool GenerateVect;
   std::string DftMeshName;
   // Store the vtkMutableDirectedGraph that represents links between family, groups and cell types
   vtkMutableDirectedGraph* SIL;
   // store the lev0 id in Tree corresponding to the TIME_STEPS in the pipeline.
   int LastLev0;
   bool GCGCP;
+#ifdef MEDREADER_USE_MPI
+  // kept from one time step to the next to reuse the ghost layer and the exchange plan while the mesh does not change
+  vtkSmartPointer<vtkMEDReaderGhostCellsGenerator> GCG;
+#endif
+  // when true the structure of the file is read from/written to an index on disk
+  bool UseIndex;
+  // empty means next to the MED file
+  std::string IndexDirectory;
+  // asynchronous prefetch of the next time step
+  bool Prefetch;
+  std::thread PrefetchThread;
+  std::atomic<bool> PrefetchInterrupt;
+  double PrefetchTime;
+  vtkDataSet *PrefetchedDS;
+  ExportedTinyInfo PrefetchedInfo;
+  // set by the background thread, read by the main thread after the join
+  bool PrefetchFailed;
+  // number of time steps served by the background build
+  int NumberOfPrefetchHits;
+  // last time requested. Used to guess the direction of the animation.
+  double LastReqTS;
+  bool HasLastReqTS;
+  // when true Reload only reads again the structure of the fields, keeping the meshes already loaded
+  bool IncrementalReload;
+  // when true the timings of the stages of the load are attached to the output as field data
+  bool TimingsInFieldData;
+  // storage of the string returned by GetTimingsReport
+  std::string TimingsReport;
 };
 
 vtkStandardNewMacro(vtkMEDReader)
 
+/*!
+ * Attaches \a timings to \a fd : one tuple per stage, named in the array "MEDReaderTimingsStages".
+ */
+static void AppendTimingsTo(vtkFieldData *fd, const MEDReaderTimings& timings)
+{
+  static const char *COMPO_NAMES[5]={"CumulativeTime","LastTime","CumulativeBytes","LastBytes","NumberOfCalls"};
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("MEDReaderTimings");
+  values->SetNumberOfComponents(5);
+  for(int i=0;i<5;i++)
+    values->SetComponentName(i,COMPO_NAMES[i]);
+  values->SetNumberOfTuples(MEDReaderTimings::NB_OF_STAGES);
+  vtkNew<vtkStringArray> names;
+  names->SetName("MEDReaderTimingsStages");
+  names->SetNumberOfValues(MEDReaderTimings::NB_OF_STAGES);
+  for(int i=0;i<MEDReaderTimings::NB_OF_STAGES;i++)
+    {
+      MEDReaderTimings::Stage stage((MEDReaderTimings::Stage)i);
+      double tuple[5]={timings.getCumulativeTime(stage),timings.getLastTime(stage),(double)timings.getCumulativeBytes(stage),(double)timings.getLastBytes(stage),(double)timings.getNumberOfCalls(stage)};
+      values->SetTypedTuple(i,tuple);
+      names->SetValue(i,MEDReaderTimings::GetStageName(stage));
+    }
+  fd->AddArray(values);
+  fd->AddArray(names);
+}
+
+/*!
+ * Rank of this process and number of processes among which the file is split. -1 for both if not run in parallel.
+ */
+static void GetPartInfo(int& iPart, int& nbOfParts)
+{
+  iPart=-1; nbOfParts=-1;
+#ifdef MEDREADER_USE_MPI
+  vtkMultiProcessController *vmpc(vtkMultiProcessController::GetGlobalController());
+  if(vmpc)
+    {
+      iPart=vmpc->GetLocalProcessId();
+      nbOfParts=vmpc->GetNumberOfProcesses();
+    }
+#endif
+}
+
 // vtkInformationKeyMacro(vtkMEDReader, META_DATA, DataObjectMetaData); // Here we need to customize vtkMEDReader::META_DATA method
 // start of overload of vtkInformationKeyMacro
 static vtkInformationDataObjectMetaDataKey *vtkMEDReader_META_DATA=new vtkInformationDataObjectMetaDataKey("META_DATA","vtkMEDReader");
@@ -144,8 +357,47 @@ vtkMEDReader::~vtkMEDReader()
 void vtkMEDReader::Reload()
 {
   std::string fName((const char *)this->GetFileName());
+  this->Internal->StopPrefetch();
+  if(this->Internal->IncrementalReload && this->Internal->Tree.getNumberOfLeavesArrays()!=0)
+    {
+      try
+        {
+          int iPart(-1),nbOfParts(-1);
+          GetPartInfo(iPart,nbOfParts);
+          if(this->Internal->Tree.reloadFieldsStructure(iPart,nbOfParts))
+            {
+              this->Internal->FieldSelection->RemoveAllArrays();
+              for(int idLeaveArray=0;idLeaveArray<this->Internal->Tree.getNumberOfLeavesArrays();idLeaveArray++)
+                this->Internal->FieldSelection->AddArray(this->Internal->Tree.getNameOf(idLeaveArray).c_str(),this->Internal->Tree.getStatusOf(idLeaveArray));
+              this->Internal->PendingFieldChanges.clear();
+              this->Internal->LastLev0=-1;// time steps of the active leaf may have been appended -> TIME_STEPS republished
+              this->Modified();
+              return ;
+            }
+        }
+      catch(INTERP_KERNEL::Exception& e)
+        {// the tree may be partially updated -> full reload below
+          vtkDebugMacro("Incremental reload failed : " << e.what());
+        }
+    }
+  int cacheSize(this->Internal->Tree.getCacheSizeLimit()),nbOfThreads(this->Internal->Tree.getNumberOfThreads());
+  bool prefetch(this->Internal->Prefetch),useIndex(this->Internal->UseIndex),incremental(this->Internal->IncrementalReload),timingsInFieldData(this->Internal->TimingsInFieldData),lazy(this->Internal->Tree.getLazyMeshLoading()),weighted(this->Internal->Tree.getWeightedPartitioning()),singlePrecision(this->Internal->Tree.getSinglePrecision()),generateVectors(this->Internal->Tree.getGenerateVectors());
+  std::string indexDir(this->Internal->IndexDirectory);
+  std::vector<INTERP_KERNEL::NormalizedCellType> geoTypes(this->Internal->Tree.getGeoTypesToLoad());
   delete this->Internal;
   this->Internal=new vtkMEDReaderInternal(this);
+  this->Internal->Tree.setCacheSizeLimit(cacheSize);
+  this->Internal->Tree.setNumberOfThreads(nbOfThreads);
+  this->Internal->Prefetch=prefetch;
+  this->Internal->UseIndex=useIndex;
+  this->Internal->IndexDirectory=indexDir;
+  this->Internal->Tree.setLazyMeshLoading(lazy);
+  this->Internal->Tree.setWeightedPartitioning(weighted);
+  this->Internal->Tree.setGeoTypesToLoad(geoTypes);
+  this->Internal->Tree.setSinglePrecision(singlePrecision);
+  this->Internal->Tree.setGenerateVectors(generateVectors);
+  this->Internal->IncrementalReload=incremental;
+  this->Internal->TimingsInFieldData=timingsInFieldData;
   this->SetFileName(fName.c_str());
 }
 
@@ -155,9 +407,10 @@ void vtkMEDReader::GenerateVectors(int val)
     return;
   
   bool val2((bool)val);
-  if(val2!=this->Internal->GenerateVect)
+  if(val2!=this->Internal->Tree.getGenerateVectors())
     {
-      this->Internal->GenerateVect=val2;
+      this->Internal->StopPrefetch();
+      this->Internal->Tree.setGenerateVectors(val2);
       this->Modified();
     }
 }
@@ -167,6 +420,7 @@ void vtkMEDReader::ChangeMode(int newMode)
   if ( !this->Internal )
     return;
   
+  this->Internal->StopPrefetch();
   this->Internal->IsStdOrMode=newMode!=0;
   this->Modified();
 }
@@ -180,10 +434,169 @@ void vtkMEDReader::GhostCellGeneratorCallForPara(int gcgcp)
   if(newVal!=this->Internal->GCGCP)
     {
       this->Internal->GCGCP=newVal;
+#ifdef MEDREADER_USE_MPI
+      this->Internal->GCG=0;
+#endif
       this->Modified();
     }
 }
 
+void vtkMEDReader::SetDataSetCacheSize(int sizeInMB)
+{
+  if ( !this->Internal )
+    return;
+  // the output is not impacted -> no call to Modified
+  this->Internal->StopPrefetch();
+  this->Internal->Tree.setCacheSizeLimit(sizeInMB);
+}
+
+void vtkMEDReader::SetNumberOfThreadsForFields(int nbOfThreads)
+{
+  if ( !this->Internal )
+    return;
+  // the output is not impacted -> no call to Modified
+  this->Internal->StopPrefetch();
+#ifdef MEDREADER_USE_MPI
+  vtkMultiProcessController *vmpc(vtkMultiProcessController::GetGlobalController());
+  if(vmpc && vmpc->GetNumberOfProcesses()>1)
+    nbOfThreads=1;// order of reads must be the same on all procs
+#endif
+  this->Internal->Tree.setNumberOfThreads(nbOfThreads);
+}
+
+void vtkMEDReader::SetPrefetchNextTimeStep(int prefetch)
+{
+  if ( !this->Internal )
+    return;
+  // the output is not impacted -> no call to Modified
+  bool newVal(prefetch!=0);
+  if(!newVal)
+    this->Internal->StopPrefetch();
+  this->Internal->Prefetch=newVal;
+}
+
+void vtkMEDReader::SetUseMetadataIndex(int useIndex)
+{
+  if ( !this->Internal )
+    return;
+  // only taken into account at the next load of the file -> no call to Modified
+  this->Internal->UseIndex=useIndex!=0;
+}
+
+void vtkMEDReader::SetMetadataIndexDirectory(const char *dirName)
+{
+  if ( !this->Internal )
+    return;
+  this->Internal->IndexDirectory=dirName?dirName:"";
+}
+
+void vtkMEDReader::SetLazyMeshLoading(int lazy)
+{
+  if ( !this->Internal )
+    return;
+  // only taken into account at the next load of the file -> no call to Modified
+  this->Internal->Tree.setLazyMeshLoading(lazy!=0);
+}
+
+void vtkMEDReader::SetWeightedPartitioning(int weighted)
+{
+  if ( !this->Internal )
+    return;
+  // only taken into account at the next load of the file -> no call to Modified
+  this->Internal->Tree.setWeightedPartitioning(weighted!=0);
+}
+
+void vtkMEDReader::SetGeoTypesToLoad(const char *geoTypes)
+{
+  if ( !this->Internal )
+    return;
+  // only taken into account at the next load of the file -> no call to Modified
+  try
+    {
+      this->Internal->Tree.setGeoTypesToLoad(MEDFileFieldRepresentationTree::ParseGeoTypes(geoTypes?geoTypes:""));
+    }
+  catch(INTERP_KERNEL::Exception& e)
+    {
+      std::ostringstream oss;
+      oss << "Exception has been thrown in vtkMEDReader::SetGeoTypesToLoad : " << e.what() << std::endl;
+      if(this->HasObserver("ErrorEvent") )
+        this->InvokeEvent("ErrorEvent",const_cast<char *>(oss.str().c_str()));
+      else
+        vtkOutputWindowDisplayErrorText(const_cast<char *>(oss.str().c_str()));
+    }
+}
+
+void vtkMEDReader::SetSinglePrecision(int singlePrecision)
+{
+  if ( !this->Internal )
+    return;
+  bool newVal(singlePrecision!=0);
+  if(newVal!=this->Internal->Tree.getSinglePrecision())
+    {
+      this->Internal->StopPrefetch();
+      this->Internal->Tree.setSinglePrecision(newVal);
+      this->Modified();
+    }
+}
+
+void vtkMEDReader::SetIncrementalReload(int incremental)
+{
+  if ( !this->Internal )
+    return;
+  // only taken into account at the next call to Reload -> no call to Modified
+  this->Internal->IncrementalReload=(incremental!=0);
+}
+
+void vtkMEDReader::SetTimingsInFieldData(int timingsInFieldData)
+{
+  if ( !this->Internal )
+    return;
+  bool newVal(timingsInFieldData!=0);
+  if(newVal!=this->Internal->TimingsInFieldData)
+    {
+      this->Internal->TimingsInFieldData=newVal;
+      this->Modified();
+    }
+}
+
+const char *vtkMEDReader::GetTimingsReport()
+{
+  if ( !this->Internal )
+    return 0;
+  this->Internal->TimingsReport=this->Internal->Tree.getTimings().getReport();
+  return this->Internal->TimingsReport.c_str();
+}
+
+int vtkMEDReader::GetNumberOfDataSetCacheHits()
+{
+  if ( !this->Internal )
+    return 0;
+  return this->Internal->Tree.getNumberOfCacheHits();
+}
+
+int vtkMEDReader::GetNumberOfDataSetCacheMisses()
+{
+  if ( !this->Internal )
+    return 0;
+  return this->Internal->Tree.getNumberOfCacheMisses();
+}
+
+int vtkMEDReader::GetNumberOfPrefetchHits()
+{
+  if ( !this->Internal )
+    return 0;
+  return this->Internal->NumberOfPrefetchHits;
+}
+
+int vtkMEDReader::GetNumberOfGhostLayerReuses()
+{
+#ifdef MEDREADER_USE_MPI
+  if ( this->Internal && this->Internal->GCG )
+    return this->Internal->GCG->GetNumberOfReuses();
+#endif
+  return 0;
+}
+
 const char *vtkMEDReader::GetSeparator()
 {
   return MEDFileFieldRepresentationLeavesArrays::ZE_SEP;
@@ -226,19 +639,23 @@ int vtkMEDReader::RequestInformation(vtkInformation *request, vtkInformationVect
     return 0;
   try
     {
+      this->Internal->StopPrefetch();
+      this->Internal->Tree.getTimings().startRequest();
       // Process file meta data
       if(this->Internal->Tree.getNumberOfLeavesArrays()==0)
         {
           int iPart(-1),nbOfParts(-1);
-#ifdef MEDREADER_USE_MPI
-          vtkMultiProcessController *vmpc(vtkMultiProcessController::GetGlobalController());
-          if(vmpc)
+          GetPartInfo(iPart,nbOfParts);
+          // the index describes the whole file -> not used when the file is split among processes or restricted to some geometric types
+          std::string indexFileName;
+          if(this->Internal->UseIndex && nbOfParts<=1 && this->Internal->Tree.getGeoTypesToLoad().empty())
+            indexFileName=MEDFileFieldRepresentationIndex::BuildIndexFileName(this->Internal->FileName,this->Internal->IndexDirectory);
+          if(indexFileName.empty() || !this->Internal->Tree.loadIndexOfFile(this->Internal->FileName.c_str(),indexFileName))
             {
-              iPart=vmpc->GetLocalProcessId();
-              nbOfParts=vmpc->GetNumberOfProcesses();
+              this->Internal->Tree.loadMainStructureOfFile(this->Internal->FileName.c_str(),iPart,nbOfParts);
+              if(!indexFileName.empty())
+                this->Internal->Tree.saveIndexOfFile(this->Internal->FileName.c_str(),indexFileName);
             }
-#endif
-          this->Internal->Tree.loadMainStructureOfFile(this->Internal->FileName.c_str(),iPart,nbOfParts);
           
           // Leaves
           this->Internal->Tree.activateTheFirst();//This line manually initialize the status of server (this) with the remote client.
@@ -262,26 +679,12 @@ int vtkMEDReader::RequestInformation(vtkInformation *request, vtkInformationVect
 
       // Make sure internal model are synchronized
       /// So the SIL is up to date
-      int nArrays = this->Internal->FieldSelection->GetNumberOfArrays();
-      for(int i = nArrays - 1; i >= 0; i--)
-      {
-        try
-        {
-        this->Internal->Tree.changeStatusOfAndUpdateToHaveCoherentVTKDataSet(
-          this->Internal->Tree.getIdHavingZeName(this->Internal->FieldSelection->GetArrayName(i)),
-          this->Internal->FieldSelection->GetArraySetting(i));
-        }
-        catch(INTERP_KERNEL::Exception& e)
-        {
-          // Remove the incorrect array
-          this->Internal->FieldSelection->RemoveArrayByIndex(i);
-        }
-      }
+      bool selectionChanged(this->Internal->SyncFieldSelection());
 
 //      request->Print(cout);
       vtkInformation *outInfo(outputVector->GetInformationObject(0));
       outInfo->Set(vtkDataObject::DATA_TYPE_NAME(),"vtkMultiBlockDataSet");
-      this->UpdateSIL(request, outInfo);
+      this->UpdateSIL(request, outInfo, selectionChanged);
 
       // Set the meta data graph as a meta data key in the information
       // That's all that is needed to transfer it along the pipeline
@@ -311,12 +714,21 @@ int vtkMEDReader::RequestData(vtkInformation *request, vtkInformationVector ** /
     return 0;
   try
   {
-      for(int i = 0; i < this->Internal->FieldSelection->GetNumberOfArrays(); i++)
-      {
-        this->Internal->Tree.changeStatusOfAndUpdateToHaveCoherentVTKDataSet(
-          this->Internal->Tree.getIdHavingZeName(this->Internal->FieldSelection->GetArrayName(i)), 
-          this->Internal->FieldSelection->GetArraySetting(i));
-      }
+      vtkInformation *outInfo(outputVector->GetInformationObject(0));
+      double reqTS(0.);
+      if(outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+        reqTS=outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+      // the background build, if any, is kept only if it targets reqTS. In all cases it is over after this call.
+      this->Internal->SyncPrefetch(reqTS);
+      this->Internal->Tree.getTimings().startRequest();
+      if(this->Internal->Tree.isIndexOnly())
+        {// RequestInformation has been answered using the index. Time to read the file.
+          int iPart(-1),nbOfParts(-1);
+          GetPartInfo(iPart,nbOfParts);
+          this->Internal->Tree.loadMainStructureOfFileIfIndexOnly(this->Internal->FileName.c_str(),iPart,nbOfParts);
+        }
+      bool selectionChanged(this->Internal->SyncFieldSelection());
+      this->Internal->Tree.completeActivatedMeshIfNeeded();
           
       auto& timeFlagsArray = this->Internal->TK.getTimesFlagArray();
       if (timeFlagsArray.size() != this->Internal->TimeFlagSelection->GetNumberOfArrays())
@@ -330,28 +742,38 @@ int vtkMEDReader::RequestData(vtkInformation *request, vtkInformationVector ** /
       }
 
 //      request->Print(cout);
-      vtkInformation *outInfo(outputVector->GetInformationObject(0));
       vtkMultiBlockDataSet *output(vtkMultiBlockDataSet::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT())));
       //bool isUpdated(false); // todo: unused
-      double reqTS(0.);
-      if(outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
-        reqTS=outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
       ExportedTinyInfo ti;
 #ifndef MEDREADER_USE_MPI
       this->FillMultiBlockDataSetInstance(output,reqTS,&ti);
 #else
       if(this->Internal->GCGCP)
 	{
-	  vtkSmartPointer<vtkPUnstructuredGridGhostCellsGenerator> gcg(vtkSmartPointer<vtkPUnstructuredGridGhostCellsGenerator>::New());
+	  if(!this->Internal->GCG)
+	    {
+	      this->Internal->GCG=vtkSmartPointer<vtkMEDReaderGhostCellsGenerator>::New();
+	      this->Internal->GCG->SetUseGlobalPointIds(true);
+	      this->Internal->GCG->SetBuildIfRequired(false);
+	    }
+	  vtkMEDReaderGhostCellsGenerator *gcg(this->Internal->GCG);
 	  {
 	    vtkDataSet *ret(RetrieveDataSetAtTime(reqTS,&ti));
 	    gcg->SetInputData(ret);
 	    ret->Delete();
 	  }
-	  gcg->SetUseGlobalPointIds(true);
-	  gcg->SetBuildIfRequired(false);
-	  gcg->Update();
-	  output->SetBlock(0,gcg->GetOutput());
+	  {
+	    MEDReaderStageTimer timer(&this->Internal->Tree.getTimings(),MEDReaderTimings::GHOST_CELLS);
+	    gcg->Update();
+	    timer.setNumberOfBytes(1024ULL*gcg->GetOutput()->GetActualMemorySize());
+	  }
+	  // the output of the generator is overwritten at next time step. Downstream keeps its own instance.
+	  vtkDataSet *gcgOut(gcg->GetOutput());
+	  vtkDataSet *block(gcgOut->NewInstance());
+	  block->ShallowCopy(gcgOut);
+	  gcg->SetInputData(0);
+	  output->SetBlock(0,block);
+	  block->Delete();
 	}
       else
 	this->FillMultiBlockDataSetInstance(output,reqTS,&ti);
@@ -364,7 +786,10 @@ int vtkMEDReader::RequestData(vtkInformation *request, vtkInformationVector ** /
         }
       output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(),reqTS);
       // Is it really needed ? TODO
-      this->UpdateSIL(request, outInfo);
+      this->UpdateSIL(request, outInfo, selectionChanged);
+      if(this->Internal->TimingsInFieldData && output->GetBlock(0))
+        AppendTimingsTo(output->GetBlock(0)->GetFieldData(),this->Internal->Tree.getTimings());
+      this->PrefetchNextTimeStepIfNeeded(reqTS);
     }
   catch(INTERP_KERNEL::Exception& e)
     {
@@ -389,6 +814,9 @@ const char* vtkMEDReader::GetFieldsTreeArrayName(int index)
 //------------------------------------------------------------------------------
 int vtkMEDReader::GetFieldsTreeArrayStatus(const char* name)
 {
+  std::unordered_map<std::string,bool>::const_iterator it(this->Internal->FieldStatus.find(name));
+  if(it!=this->Internal->FieldStatus.end())
+    return (*it).second?1:0;
   return this->Internal->FieldSelection->ArrayIsEnabled(name);
 }
 
@@ -397,6 +825,7 @@ void vtkMEDReader::SetFieldsStatus(const char* name, int status)
 {
   if (this->GetFieldsTreeArrayStatus(name) != status)
   {
+    this->Internal->StopPrefetch();
     if (status)
     {
       this->Internal->FieldSelection->EnableArray(name);
@@ -405,6 +834,8 @@ void vtkMEDReader::SetFieldsStatus(const char* name, int status)
     {
       this->Internal->FieldSelection->DisableArray(name);
     }
+    this->Internal->FieldStatus[name]=status!=0;
+    this->Internal->PendingFieldChanges.insert(name);
     this->Modified();
   }
 }
@@ -432,6 +863,7 @@ void vtkMEDReader::SetTimesFlagsStatus(const char* name, int status)
 {
   if (this->GetTimesFlagsArrayStatus(name) != status)
   {
+    this->Internal->StopPrefetch();
     if (status)
     {
       this->Internal->TimeFlagSelection->EnableArray(name);
@@ -444,19 +876,27 @@ void vtkMEDReader::SetTimesFlagsStatus(const char* name, int status)
   }
 }
 
-void vtkMEDReader::UpdateSIL(vtkInformation* /*request*/, vtkInformation * /*info*/)
+/*!
+ * The SIL depends on the structure of the file and on the active mesh only. The active mesh is looked for only if \a selectionChanged.
+ */
+void vtkMEDReader::UpdateSIL(vtkInformation* /*request*/, vtkInformation * /*info*/, bool selectionChanged)
 {
   if(!this->Internal)
       return;
+  int stamp(this->Internal->Tree.getStructureStamp());
+  if(this->Internal->SIL && stamp==this->Internal->SILStructureStamp && !selectionChanged)
+    return;
   std::string meshName(this->Internal->Tree.getActiveMeshName());
-  if(!this->Internal->SIL || meshName!=this->Internal->DftMeshName)
+  if(!this->Internal->SIL || stamp!=this->Internal->SILStructureStamp || meshName!=this->Internal->DftMeshName)
     {
+      MEDReaderStageTimer timer(&this->Internal->Tree.getTimings(),MEDReaderTimings::SIL);
       vtkMutableDirectedGraph *sil(vtkMutableDirectedGraph::New());
       this->BuildSIL(sil);
       if(this->Internal->SIL)
         this->Internal->SIL->Delete();
       this->Internal->SIL=sil;
       this->Internal->DftMeshName=meshName;
+      this->Internal->SILStructureStamp=stamp;
     }
 }
 
@@ -535,21 +975,45 @@ void vtkMEDReader::FillMultiBlockDataSetInstance(vtkMultiBlockDataSet *output, d
   ret->Delete();
 }
 
+/*!
+ * Launches in background the build of the time step following \a reqTS in the direction of the animation.
+ * Not performed in mode mode (all time steps are in the same dataset) nor in parallel (reads may be collective).
+ */
+void vtkMEDReader::PrefetchNextTimeStepIfNeeded(double reqTS)
+{
+  if(!this->Internal)
+    return;
+  bool forward(!this->Internal->HasLastReqTS || reqTS>=this->Internal->LastReqTS);
+  this->Internal->LastReqTS=reqTS;
+  this->Internal->HasLastReqTS=true;
+  if(!this->Internal->Prefetch || this->Internal->IsStdOrMode)
+    return;
+#ifdef MEDREADER_USE_MPI
+  vtkMultiProcessController *vmpc(vtkMultiProcessController::GetGlobalController());
+  if(vmpc && vmpc->GetNumberOfProcesses()>1)
+    return;
+#endif
+  int lev0(-1);
+  std::vector<double> tsteps(this->Internal->Tree.getTimeSteps(lev0,this->Internal->TK));
+  std::vector<double>::const_iterator it(std::find(tsteps.begin(),tsteps.end(),reqTS));
+  if(it==tsteps.end())
+    return;
+  std::ptrdiff_t pos(std::distance(tsteps.begin(),it)),next(forward?pos+1:pos-1);
+  if(next<0 || next>=(std::ptrdiff_t)tsteps.size())
+    return;
+  this->Internal->StartPrefetch(tsteps[next]);
+}
+
 vtkDataSet *vtkMEDReader::RetrieveDataSetAtTime(double reqTS, ExportedTinyInfo *internalInfo)
 {
   if( !this->Internal )
     return 0;
   std::string meshName;
-  vtkDataSet *ret(this->Internal->Tree.buildVTKInstance(this->Internal->IsStdOrMode,reqTS,meshName,this->Internal->TK,internalInfo));
-  if(this->Internal->GenerateVect)
-    {
-      vtkGenerateVectors::Operate(ret->GetPointData());
-      vtkGenerateVectors::Operate(ret->GetCellData());
-      vtkGenerateVectors::Operate(ret->GetFieldData());
-      // The operations above have potentially created new arrays -> This breaks the optimization of StaticMesh that expects the same field arrays over time.
-      // To enforce the cache recomputation declare modification of mesh.
-      //vtkGenerateVectors::ChangeMeshTimeToUpdateCache(ret);
-    }
+  vtkDataSet *ret(this->Internal->TakePrefetched(reqTS,internalInfo));
+  if(!ret)
+    ret=this->Internal->Tree.buildVTKInstance(this->Internal->IsStdOrMode,reqTS,meshName,this->Internal->TK,internalInfo);
+  // vectors, if requested, have been generated by the tree : the mesh MTime is kept and the set of arrays is the same at each time step,
+  // as expected by the StaticMesh optimization.
   return ret;
 }
 
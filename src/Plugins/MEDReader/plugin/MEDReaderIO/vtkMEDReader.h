@@ -65,6 +65,37 @@ class VTK_EXPORT vtkMEDReader : public vtkMultiBlockDataSetAlgorithm
   virtual void GenerateVectors(int);
   virtual void ChangeMode(int);
   virtual void GhostCellGeneratorCallForPara(int);
+  //! Memory budget in MB of the cache of datasets already built. 0 disables the cache.
+  virtual void SetDataSetCacheSize(int);
+  //! Number of threads used to read and convert the arrays of a time step. 1 (default) means sequential.
+  virtual void SetNumberOfThreadsForFields(int);
+  //! When true the next time step is read in background while the current one is processed downstream.
+  virtual void SetPrefetchNextTimeStep(int);
+  //! When true the structure of the file is read from an index on disk if it is up to date, and the index is written otherwise.
+  virtual void SetUseMetadataIndex(int);
+  //! Directory where the indexes are stored. Empty (default) means next to the MED file.
+  virtual void SetMetadataIndexDirectory(const char *);
+  //! When true the family, numbering and name arrays of a mesh are read only when one of its leaves is activated.
+  virtual void SetLazyMeshLoading(int);
+  //! When true, in parallel, each geometric type is split among the ranks so that the number of nodes and Gauss points is balanced.
+  virtual void SetWeightedPartitioning(int);
+  //! Comma separated geometric types (QUAD4,TRI3...). When not empty only the cells of these types and the field values on them are read.
+  virtual void SetGeoTypesToLoad(const char *);
+  //! When true coordinates and FLOAT64 fields are output in float32, numbering arrays in int32 when possible.
+  virtual void SetSinglePrecision(int);
+  //! When true Reload only reads again the fields and time steps of the file, keeping the meshes already loaded, if the meshes did not change.
+  virtual void SetIncrementalReload(int);
+  //! When true the timings of the stages of the load are attached to the output dataset as field data arrays "MEDReaderTimings" and "MEDReaderTimingsStages".
+  virtual void SetTimingsInFieldData(int);
+  //! One line per stage : name, cumulative time, last time (in s), cumulative bytes, last bytes and number of calls.
+  virtual const char *GetTimingsReport();
+  //! Number of requests served (hits) or not (misses) by the cache of datasets (see SetDataSetCacheSize).
+  virtual int GetNumberOfDataSetCacheHits();
+  virtual int GetNumberOfDataSetCacheMisses();
+  //! Number of time steps served by the asynchronous prefetch (see SetPrefetchNextTimeStep) instead of being built on request.
+  virtual int GetNumberOfPrefetchHits();
+  //! Number of time steps whose ghost layer has been deduced from the one of a previous time step. Always 0 without MPI.
+  virtual int GetNumberOfGhostLayerReuses();
   static const char *GetSeparator();
 
   // Description
@@ -78,10 +109,11 @@ class VTK_EXPORT vtkMEDReader : public vtkMultiBlockDataSetAlgorithm
   virtual int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
   virtual int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
  private:
-  void UpdateSIL(vtkInformation * request, vtkInformation * info);
+  void UpdateSIL(vtkInformation * request, vtkInformation * info, bool selectionChanged);
   virtual double PublishTimeStepsIfNeeded(vtkInformation*, bool& isUpdated);
   virtual void FillMultiBlockDataSetInstance(vtkMultiBlockDataSet *output, double reqTS, ExportedTinyInfo *internalInfo=0);
   vtkDataSet *RetrieveDataSetAtTime(double reqTS, ExportedTinyInfo *internalInfo);
+  void PrefetchNextTimeStepIfNeeded(double reqTS);
  private:
   //BTX
   //ETX
@@ -0,0 +1,403 @@
+// Copyright (C) 2010-2021  CEA/DEN, EDF R&D
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#include "vtkMEDReaderGhostCellsGenerator.h"
+
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkMPICommunicator.h"
+#include "vtkMPIController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <sstream>
+
+// tags distinct from the ones of vtkPUnstructuredGridGhostCellsGenerator and of the StaticMesh plugin
+static const int MEDREADER_GCG_SIZE_EXCHANGE_TAG=9102;
+static const int MEDREADER_GCG_DATA_EXCHANGE_TAG=9103;
+
+// arrays added to the input of the first execution to know where the ghosts come from. Removed from the output.
+static const char MEDREADER_GCG_IDS_NAME[]="vtkMEDReaderGhostIds";
+static const char MEDREADER_GCG_RANK_NAME[]="vtkMEDReaderGhostRank";
+
+vtkStandardNewMacro(vtkMEDReaderGhostCellsGenerator)
+
+/*!
+ * Adds to \a data the local id and the rank of each of its \a nbOfTuples tuples.
+ */
+static void AddIdsAndRankArrays(vtkDataSetAttributes *data, vtkIdType nbOfTuples, int rank)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName(MEDREADER_GCG_IDS_NAME);
+  ids->SetNumberOfTuples(nbOfTuples);
+  vtkNew<vtkIntArray> ranks;
+  ranks->SetName(MEDREADER_GCG_RANK_NAME);
+  ranks->SetNumberOfTuples(nbOfTuples);
+  for(vtkIdType i=0;i<nbOfTuples;i++)
+    {
+      ids->SetValue(i,i);
+      ranks->SetValue(i,rank);
+    }
+  data->AddArray(ids);
+  data->AddArray(ranks);
+}
+
+/*!
+ * Returns a list of \a nb ids going from 0 to \a nb - 1.
+ */
+static vtkSmartPointer<vtkIdList> BuildIota(vtkIdType nb)
+{
+  vtkSmartPointer<vtkIdList> ret(vtkSmartPointer<vtkIdList>::New());
+  ret->SetNumberOfIds(nb);
+  for(vtkIdType i=0;i<nb;i++)
+    ret->SetId(i,i);
+  return ret;
+}
+
+/*!
+ * Appends to \a oss a description of the arrays of \a data. Returns false if an array has no name or the same name as another one,
+ * because ghost values are dispatched by name.
+ */
+static bool AppendArraysKey(vtkDataSetAttributes *data, std::ostringstream& oss)
+{
+  std::set<std::string> names;
+  for(int i=0;i<data->GetNumberOfArrays();i++)
+    {
+      vtkAbstractArray *arr(data->GetAbstractArray(i));
+      if(!arr || !arr->GetName())
+        return false;
+      std::string name(arr->GetName());
+      if(!names.insert(name).second)
+        return false;
+      oss << name.size() << ":" << name << "/" << arr->GetDataType() << "/" << arr->GetNumberOfComponents() << ";";
+    }
+  return true;
+}
+
+/*!
+ * Fills \a outData with arrays of \a nbOfTuples tuples having the same name, type and information than the ones of \a inData.
+ * The \a nbOfLocalTuples first tuples are copied from \a inData, the remaining ones (ghosts) are left to ExchangeGhostTuples.
+ */
+static void CopyLocalTuples(vtkDataSetAttributes *inData, vtkDataSetAttributes *outData, vtkIdType nbOfLocalTuples, vtkIdType nbOfTuples)
+{
+  for(int i=0;i<inData->GetNumberOfArrays();i++)
+    {
+      vtkAbstractArray *inArr(inData->GetAbstractArray(i));
+      if(!strcmp(inArr->GetName(),vtkDataSetAttributes::GhostArrayName()))
+        continue;
+      vtkAbstractArray *arr(inArr->NewInstance());
+      arr->SetName(inArr->GetName());
+      arr->SetNumberOfComponents(inArr->GetNumberOfComponents());
+      arr->CopyComponentNames(inArr);
+      if(inArr->HasInformation())
+        arr->CopyInformation(inArr->GetInformation(),1);
+      arr->SetNumberOfTuples(nbOfTuples);
+      arr->InsertTuples(0,nbOfLocalTuples,0,inArr);
+      outData->AddArray(arr);
+      arr->Delete();
+    }
+  for(int attr=0;attr<vtkDataSetAttributes::NUM_ATTRIBUTES;attr++)
+    {
+      vtkAbstractArray *att(inData->GetAbstractAttribute(attr));
+      if(att && att->GetName())
+        outData->SetActiveAttribute(att->GetName(),attr);
+    }
+}
+
+vtkMEDReaderGhostCellsGenerator::vtkMEDReaderGhostCellsGenerator():NumberOfReuses(0)
+{
+}
+
+vtkMEDReaderGhostCellsGenerator::~vtkMEDReaderGhostCellsGenerator()
+{
+}
+
+void vtkMEDReaderGhostCellsGenerator::InvalidateCache()
+{
+  this->CacheKey.clear();
+  this->Cache->Initialize();
+  this->GhostPointsToReceive.clear();
+  this->GhostCellsToReceive.clear();
+  this->GhostPointsToSend.clear();
+  this->GhostCellsToSend.clear();
+}
+
+int vtkMEDReaderGhostCellsGenerator::RequestData(vtkInformation *request, vtkInformationVector **inputVector, vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo(inputVector[0]->GetInformationObject(0));
+  vtkInformation *outInfo(outputVector->GetInformationObject(0));
+  vtkUnstructuredGrid *input(vtkUnstructuredGrid::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT())));
+  vtkUnstructuredGrid *output(vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT())));
+  vtkMPIController *controller(vtkMPIController::SafeDownCast(this->GetController()));
+  if(!input || !output || !controller)
+    {
+      this->InvalidateCache();
+      return this->Superclass::RequestData(request,inputVector,outputVector);
+    }
+  // same computation of the number of layers than the superclass
+  int ghostLevel(outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()));
+  if(!this->GetBuildIfRequired())
+    ghostLevel=std::max(ghostLevel,this->GetNumberOfGhostLayers());
+  std::string key(this->BuildCacheKey(input,ghostLevel));
+  if(this->IsCacheValidOnAllRanks(key,controller))
+    {
+      this->UpdateFromCache(input,output,controller);
+      this->NumberOfReuses++;
+      return 1;
+    }
+  // full computation on an input enriched with the origin of each point and cell
+  vtkNew<vtkUnstructuredGrid> tmpInput;
+  tmpInput->ShallowCopy(input);
+  int rank(controller->GetLocalProcessId());
+  AddIdsAndRankArrays(tmpInput->GetPointData(),tmpInput->GetNumberOfPoints(),rank);
+  AddIdsAndRankArrays(tmpInput->GetCellData(),tmpInput->GetNumberOfCells(),rank);
+  vtkNew<vtkInformationVector> tmpInputVec;
+  tmpInputVec->Copy(inputVector[0],1);
+  tmpInputVec->GetInformationObject(0)->Set(vtkDataObject::DATA_OBJECT(),tmpInput);
+  vtkInformationVector *tmpInputVecPt(tmpInputVec);
+  int ret(this->Superclass::RequestData(request,&tmpInputVecPt,outputVector));
+  this->CacheKey=ret ? key : std::string();
+  this->BuildExchangePlan(output,controller);
+  return ret;
+}
+
+/*!
+ * Returns a string identifying the mesh of \a input and the layout of its arrays. Empty if the output for \a input can't be deduced from a cache.
+ */
+std::string vtkMEDReaderGhostCellsGenerator::BuildCacheKey(vtkUnstructuredGrid *input, int ghostLevel) const
+{
+  std::ostringstream oss;
+  oss << input->GetMeshMTime() << "/" << input->GetNumberOfPoints() << "/" << input->GetNumberOfCells() << "/" << ghostLevel << "/" << this->GetUseGlobalPointIds() << "|";
+  if(!AppendArraysKey(input->GetPointData(),oss))
+    return std::string();
+  oss << "|";
+  if(!AppendArraysKey(input->GetCellData(),oss))
+    return std::string();
+  return oss.str();
+}
+
+/*!
+ * Collective. The cache is used only if it is valid on all ranks because the full computation is collective too.
+ */
+bool vtkMEDReaderGhostCellsGenerator::IsCacheValidOnAllRanks(const std::string& key, vtkMPIController *controller) const
+{
+  int localValid(!key.empty() && key==this->CacheKey && (int)this->GhostCellsToSend.size()==controller->GetNumberOfProcesses() ? 1 : 0),globalValid(0);
+  controller->AllReduce(&localValid,&globalValid,1,vtkCommunicator::MIN_OP);
+  return globalValid==1;
+}
+
+/*!
+ * Collective. Computes from the output of the full computation the ghost points and cells to receive from each rank,
+ * and exchanges these lists so that each rank knows what to send. Then keeps the topology of \a output in the cache
+ * and removes from \a output the arrays added to the input.
+ */
+void vtkMEDReaderGhostCellsGenerator::BuildExchangePlan(vtkUnstructuredGrid *output, vtkMPIController *controller)
+{
+  int nbProc(controller->GetNumberOfProcesses()),rank(controller->GetLocalProcessId());
+  this->GhostPointsToReceive.resize(nbProc); this->GhostCellsToReceive.resize(nbProc);
+  this->GhostPointsToSend.resize(nbProc); this->GhostCellsToSend.resize(nbProc);
+  for(int i=0;i<nbProc;i++)
+    {
+      this->GhostPointsToReceive[i]=vtkSmartPointer<vtkIdList>::New();
+      this->GhostCellsToReceive[i]=vtkSmartPointer<vtkIdList>::New();
+      this->GhostPointsToSend[i]=vtkSmartPointer<vtkIdList>::New();
+      this->GhostCellsToSend[i]=vtkSmartPointer<vtkIdList>::New();
+    }
+  bool isOK(true);
+  vtkDataSetAttributes *datas[2]={output->GetPointData(),output->GetCellData()};
+  vtkUnsignedCharArray *ghosts[2]={vtkUnsignedCharArray::SafeDownCast(output->GetPointData()->GetArray(vtkDataSetAttributes::GhostArrayName())),
+                                   vtkUnsignedCharArray::SafeDownCast(output->GetCellData()->GetArray(vtkDataSetAttributes::GhostArrayName()))};
+  unsigned char ghostFlags[2]={vtkDataSetAttributes::DUPLICATEPOINT,vtkDataSetAttributes::DUPLICATECELL};
+  std::vector< vtkSmartPointer<vtkIdList> > *toReceive[2]={&this->GhostPointsToReceive,&this->GhostCellsToReceive};
+  std::vector< vtkSmartPointer<vtkIdList> > *toSend[2]={&this->GhostPointsToSend,&this->GhostCellsToSend};
+  for(int entity=0;entity<2;entity++)
+    {
+      vtkIdTypeArray *ids(vtkIdTypeArray::SafeDownCast(datas[entity]->GetAbstractArray(MEDREADER_GCG_IDS_NAME)));
+      vtkIntArray *ranks(vtkIntArray::SafeDownCast(datas[entity]->GetAbstractArray(MEDREADER_GCG_RANK_NAME)));
+      std::vector< std::vector<vtkIdType> > remoteIds(nbProc);
+      if(!ghosts[entity])// no ghost at all, for example on a single rank
+        ;
+      else if(!ids || !ranks)
+        isOK=false;
+      else
+        {
+          vtkIdType nbOfTuples(ghosts[entity]->GetNumberOfTuples());
+          for(vtkIdType i=0;i<nbOfTuples;i++)
+            {
+              if(!(ghosts[entity]->GetValue(i) & ghostFlags[entity]))
+                continue;
+              int origin(ranks->GetValue(i));
+              if(origin<0 || origin>=nbProc || origin==rank)
+                {
+                  isOK=false;
+                  continue;
+                }
+              (*toReceive[entity])[origin]->InsertNextId(i);
+              remoteIds[origin].push_back(ids->GetValue(i));
+            }
+        }
+      // each rank tells the others which of their entities it needs. Sizes are always sent, even empty, to keep ranks in sync.
+      std::vector<vtkIdType> lengths(nbProc,0);
+      std::vector<vtkMPICommunicator::Request> sizeReqs(nbProc),dataReqs(nbProc);
+      for(int i=0;i<nbProc;i++)
+        {
+          if(i==rank)
+            continue;
+          lengths[i]=(vtkIdType)remoteIds[i].size();
+          controller->NoBlockSend(&lengths[i],1,i,MEDREADER_GCG_SIZE_EXCHANGE_TAG,sizeReqs[i]);
+          if(lengths[i]>0)
+            controller->NoBlockSend(&remoteIds[i][0],(int)lengths[i],i,MEDREADER_GCG_DATA_EXCHANGE_TAG,dataReqs[i]);
+        }
+      for(int i=0;i<nbProc;i++)
+        {
+          if(i==rank)
+            continue;
+          vtkIdType length(0);
+          controller->Receive(&length,1,i,MEDREADER_GCG_SIZE_EXCHANGE_TAG);
+          (*toSend[entity])[i]->SetNumberOfIds(length);
+          if(length>0)
+            controller->Receive((*toSend[entity])[i]->GetPointer(0),length,i,MEDREADER_GCG_DATA_EXCHANGE_TAG);
+        }
+      for(int i=0;i<nbProc;i++)
+        {
+          if(i==rank)
+            continue;
+          sizeReqs[i].Wait();
+          if(lengths[i]>0)
+            dataReqs[i].Wait();
+        }
+      datas[entity]->RemoveArray(MEDREADER_GCG_IDS_NAME);
+      datas[entity]->RemoveArray(MEDREADER_GCG_RANK_NAME);
+    }
+  this->Cache->Initialize();
+  if(!isOK)
+    {
+      vtkWarningMacro("Origin of ghost entities is unknown. The ghost layer will be recomputed at each execution.");
+      this->CacheKey.clear();
+      return ;
+    }
+  this->Cache->CopyStructure(output);
+  if(ghosts[0])
+    this->Cache->GetPointData()->AddArray(ghosts[0]);
+  if(ghosts[1])
+    this->Cache->GetCellData()->AddArray(ghosts[1]);
+}
+
+/*!
+ * Collective. Builds \a output from the cached topology : local tuples come from \a input, ghost tuples are received from their owner.
+ * Arrays of \a output are new ones, so that outputs of previous executions are left unchanged.
+ */
+void vtkMEDReaderGhostCellsGenerator::UpdateFromCache(vtkUnstructuredGrid *input, vtkUnstructuredGrid *output, vtkMPIController *controller) const
+{
+  output->Initialize();
+  output->CopyStructure(this->Cache);
+  CopyLocalTuples(input->GetPointData(),output->GetPointData(),input->GetNumberOfPoints(),this->Cache->GetNumberOfPoints());
+  CopyLocalTuples(input->GetCellData(),output->GetCellData(),input->GetNumberOfCells(),this->Cache->GetNumberOfCells());
+  ExchangeGhostTuples(input->GetPointData(),output->GetPointData(),this->GhostPointsToSend,this->GhostPointsToReceive,controller);
+  ExchangeGhostTuples(input->GetCellData(),output->GetCellData(),this->GhostCellsToSend,this->GhostCellsToReceive,controller);
+  vtkAbstractArray *pointGhosts(this->Cache->GetPointData()->GetAbstractArray(vtkDataSetAttributes::GhostArrayName()));
+  if(pointGhosts)
+    output->GetPointData()->AddArray(pointGhosts);
+  vtkAbstractArray *cellGhosts(this->Cache->GetCellData()->GetAbstractArray(vtkDataSetAttributes::GhostArrayName()));
+  if(cellGhosts)
+    output->GetCellData()->AddArray(cellGhosts);
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+}
+
+/*!
+ * Collective. Sends to each rank the tuples of \a inData it needs as ghosts, marshalled in a table, and puts the received tuples in \a outData.
+ */
+void vtkMEDReaderGhostCellsGenerator::ExchangeGhostTuples(vtkDataSetAttributes *inData, vtkDataSetAttributes *outData,
+                                                          const std::vector< vtkSmartPointer<vtkIdList> >& toSend,
+                                                          const std::vector< vtkSmartPointer<vtkIdList> >& toReceive, vtkMPIController *controller)
+{
+  int nbProc(controller->GetNumberOfProcesses()),rank(controller->GetLocalProcessId());
+  std::vector< vtkSmartPointer<vtkCharArray> > buffers(nbProc);
+  std::vector<vtkIdType> lengths(nbProc,0);
+  std::vector<vtkMPICommunicator::Request> sizeReqs(nbProc),dataReqs(nbProc);
+  for(int i=0;i<nbProc;i++)
+    {
+      if(i==rank || toSend[i]->GetNumberOfIds()==0)
+        continue;
+      vtkSmartPointer<vtkIdList> dstIds(BuildIota(toSend[i]->GetNumberOfIds()));
+      vtkNew<vtkTable> table;
+      for(int j=0;j<inData->GetNumberOfArrays();j++)
+        {
+          vtkAbstractArray *inArr(inData->GetAbstractArray(j));
+          vtkAbstractArray *arr(inArr->NewInstance());
+          arr->SetName(inArr->GetName());
+          arr->SetNumberOfComponents(inArr->GetNumberOfComponents());
+          arr->InsertTuples(dstIds,toSend[i],inArr);
+          table->AddColumn(arr);
+          arr->Delete();
+        }
+      buffers[i]=vtkSmartPointer<vtkCharArray>::New();
+      vtkCommunicator::MarshalDataObject(table,buffers[i]);
+      lengths[i]=buffers[i]->GetNumberOfTuples();
+      controller->NoBlockSend(&lengths[i],1,i,MEDREADER_GCG_SIZE_EXCHANGE_TAG,sizeReqs[i]);
+      controller->NoBlockSend(buffers[i]->GetPointer(0),(int)lengths[i],i,MEDREADER_GCG_DATA_EXCHANGE_TAG,dataReqs[i]);
+    }
+  for(int i=0;i<nbProc;i++)
+    {
+      if(i==rank || toReceive[i]->GetNumberOfIds()==0)
+        continue;
+      vtkIdType length(0);
+      controller->Receive(&length,1,i,MEDREADER_GCG_SIZE_EXCHANGE_TAG);
+      vtkNew<vtkCharArray> recvBuffer;
+      recvBuffer->SetNumberOfValues(length);
+      controller->Receive(recvBuffer->GetPointer(0),length,i,MEDREADER_GCG_DATA_EXCHANGE_TAG);
+      vtkNew<vtkTable> table;
+      vtkCommunicator::UnMarshalDataObject(recvBuffer,table);
+      vtkSmartPointer<vtkIdList> srcIds(BuildIota(toReceive[i]->GetNumberOfIds()));
+      for(vtkIdType j=0;j<table->GetNumberOfColumns();j++)
+        {
+          vtkAbstractArray *arr(outData->GetAbstractArray(table->GetColumnName(j)));
+          if(arr)
+            arr->InsertTuples(toReceive[i],srcIds,table->GetColumn(j));
+        }
+    }
+  for(int i=0;i<nbProc;i++)
+    {
+      if(i==rank || toSend[i]->GetNumberOfIds()==0)
+        continue;
+      sizeReqs[i].Wait();
+      dataReqs[i].Wait();
+    }
+}
+
+void vtkMEDReaderGhostCellsGenerator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+  os << indent << "Cache valid: " << (this->CacheKey.empty() ? "no" : "yes") << endl;
+  os << indent << "Number of reuses: " << this->NumberOfReuses << endl;
+}
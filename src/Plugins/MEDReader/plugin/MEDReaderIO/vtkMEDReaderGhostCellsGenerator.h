@@ -0,0 +1,86 @@
+// Copyright (C) 2010-2021  CEA/DEN, EDF R&D
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#ifndef __vtkMEDReaderGhostCellsGenerator_h_
+#define __vtkMEDReaderGhostCellsGenerator_h_
+
+#include "vtkPUnstructuredGridGhostCellsGenerator.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <string>
+#include <vector>
+
+class vtkDataSetAttributes;
+class vtkMPIController;
+class vtkUnstructuredGrid;
+class vtkUnsignedCharArray;
+
+/*!
+ * Ghost cells generator kept alive by vtkMEDReader from one time step to the next.
+ * The first execution runs the full ghost layer computation of the superclass and keeps the resulting topology
+ * together with the list of the ghost points and cells to exchange with each rank.
+ * As long as the mesh of the input is the same (same mesh MTime, same number of entities and same arrays on all ranks)
+ * next executions only copy the local tuples and exchange the values of the ghost tuples.
+ */
+class VTK_EXPORT vtkMEDReaderGhostCellsGenerator : public vtkPUnstructuredGridGhostCellsGenerator
+{
+public:
+  static vtkMEDReaderGhostCellsGenerator *New();
+  vtkTypeMacro(vtkMEDReaderGhostCellsGenerator, vtkPUnstructuredGridGhostCellsGenerator)
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //! Number of executions that reused the ghost layer of a previous one. For diagnostics and tests.
+  vtkGetMacro(NumberOfReuses, int);
+  //! Forgets the ghost layer. Next execution will recompute it.
+  void InvalidateCache();
+
+protected:
+  vtkMEDReaderGhostCellsGenerator();
+  ~vtkMEDReaderGhostCellsGenerator() override;
+  int RequestData(vtkInformation *request, vtkInformationVector **inputVector, vtkInformationVector *outputVector) override;
+
+private:
+  std::string BuildCacheKey(vtkUnstructuredGrid *input, int ghostLevel) const;
+  bool IsCacheValidOnAllRanks(const std::string& key, vtkMPIController *controller) const;
+  void BuildExchangePlan(vtkUnstructuredGrid *output, vtkMPIController *controller);
+  void UpdateFromCache(vtkUnstructuredGrid *input, vtkUnstructuredGrid *output, vtkMPIController *controller) const;
+  static void ExchangeGhostTuples(vtkDataSetAttributes *inData, vtkDataSetAttributes *outData,
+                                  const std::vector< vtkSmartPointer<vtkIdList> >& toSend,
+                                  const std::vector< vtkSmartPointer<vtkIdList> >& toReceive, vtkMPIController *controller);
+
+private:
+  vtkMEDReaderGhostCellsGenerator(const vtkMEDReaderGhostCellsGenerator&) = delete;
+  void operator=(const vtkMEDReaderGhostCellsGenerator&) = delete;
+
+private:
+  //! topology of the last output and its ghost type arrays. No field array.
+  vtkNew<vtkUnstructuredGrid> Cache;
+  //! empty when the cache is not valid
+  std::string CacheKey;
+  //! for each rank, local ids of the ghost points/cells received from it
+  std::vector< vtkSmartPointer<vtkIdList> > GhostPointsToReceive;
+  std::vector< vtkSmartPointer<vtkIdList> > GhostCellsToReceive;
+  //! for each rank, local ids of the points/cells it needs as ghosts
+  std::vector< vtkSmartPointer<vtkIdList> > GhostPointsToSend;
+  std::vector< vtkSmartPointer<vtkIdList> > GhostCellsToSend;
+  int NumberOfReuses;
+};
+
+#endif
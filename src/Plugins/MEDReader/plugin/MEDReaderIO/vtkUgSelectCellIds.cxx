@@ -27,6 +27,11 @@
 #include "vtkInformation.h"
 #include "vtkCellData.h"
 #include "vtkPointData.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkNew.h"
+
+#include <algorithm>
 
 vtkStandardNewMacro(vtkUgSelectCellIds)
 
@@ -35,6 +40,156 @@ void vtkUgSelectCellIds::SetIds(vtkIdTypeArray *ids)
   _ids = ids;
 }
 
+void vtkUgSelectCellIds::SetCompactPoints(bool compactPoints)
+{
+  if( _compact_points != compactPoints )
+  {
+    _compact_points = compactPoints;
+    this->Modified();
+  }
+}
+
+/*!
+ * Gathers in \a dst the tuples \a ids of all the arrays of \a src.
+ */
+static void GatherArrays(vtkDataSetAttributes *src, vtkIdList *ids, vtkDataSetAttributes *dst)
+{
+  for( int fieldId = 0 ; fieldId < src->GetNumberOfArrays() ; ++fieldId )
+  {
+    vtkDataArray *array( src->GetArray(fieldId) );
+    if( !array )
+      continue;
+    vtkSmartPointer<vtkDataArray> outArray;
+    outArray.TakeReference( array->NewInstance() );
+    outArray->SetNumberOfComponents(array->GetNumberOfComponents()); outArray->SetNumberOfTuples(ids->GetNumberOfIds());
+    outArray->SetName(array->GetName());
+    array->GetTuples(ids,outArray);
+    dst->AddArray(outArray);
+  }
+}
+
+/*!
+ * Builds the unstructured grid made of the cells \a cellIds of \a ds, in this order. Face streams of polyhedra are kept.
+ * Without \a compactPoints the output lies on the points of \a ds and shares its point arrays. With \a compactPoints only the points
+ * of the selected cells are kept, numbered in the order of their first use, and the connectivity and the point arrays follow.
+ * \a ptIds, \a faceStream and \a pointMap are work arrays, so that this method can be called from several threads at once. \a pointMap is
+ * either empty or filled with -1, and it is left that way : only the entries of the kept points are reset, so that it is reused at no
+ * O(number of points of \a ds) cost.
+ */
+vtkSmartPointer<vtkUnstructuredGrid> vtkUgSelectCellIds::SelectCellIds(vtkUnstructuredGrid *ds, const vtkIdType *cellIds, vtkIdType nbOfCellIds, bool compactPoints, vtkIdList *ptIds, vtkIdList *faceStream, std::vector<vtkIdType>& pointMap)
+{
+  vtkSmartPointer<vtkUnstructuredGrid> ret(vtkSmartPointer<vtkUnstructuredGrid>::New());
+  vtkIdType outConnLgth(0);
+  for( vtkIdType i = 0 ; i < nbOfCellIds ; ++i )
+    outConnLgth += 1+ds->GetCellSize(cellIds[i]);
+  vtkNew<vtkIdTypeArray> outNodalConn;
+  outNodalConn->SetNumberOfComponents(1); outNodalConn->SetNumberOfTuples(outConnLgth);
+  vtkNew<vtkUnsignedCharArray> outCellTypes;
+  outCellTypes->SetNumberOfComponents(1); outCellTypes->SetNumberOfTuples(nbOfCellIds);
+  vtkNew<vtkIdTypeArray> outCellLocations;
+  outCellLocations->SetNumberOfComponents(1); outCellLocations->SetNumberOfTuples(nbOfCellIds);
+  vtkSmartPointer<vtkIdTypeArray> outFaceLocations,outFaces;
+  if( ds->GetFaces() )
+  {
+    outFaceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+    outFaceLocations->SetNumberOfComponents(1); outFaceLocations->SetNumberOfTuples(nbOfCellIds);
+    outFaces = vtkSmartPointer<vtkIdTypeArray>::New();
+  }
+  // with compactPoints, pointMap gives the id in output of each point of ds, and pointIds the id in ds of each point of output
+  vtkNew<vtkIdList> pointIds;
+  if( compactPoints && (vtkIdType)pointMap.size() != ds->GetNumberOfPoints() )
+    pointMap.assign(ds->GetNumberOfPoints(),-1);
+  auto outPointId = [compactPoints,&pointMap,&pointIds](vtkIdType ptId)
+  {
+    if( !compactPoints )
+      return ptId;
+    if( pointMap[ptId] < 0 )
+    {
+      pointMap[ptId] = pointIds->GetNumberOfIds();
+      pointIds->InsertNextId(ptId);
+    }
+    return pointMap[ptId];
+  };
+  vtkIdType *outConnPt(outNodalConn->GetPointer(0)),*outCellLocPt(outCellLocations->GetPointer(0));
+  unsigned char *outCellTypePt(outCellTypes->GetPointer(0));
+  vtkIdType outCurCellLoc(0);
+  for( vtkIdType i = 0 ; i < nbOfCellIds ; ++i )
+  {
+    ds->GetCellPoints(cellIds[i],ptIds);
+    vtkIdType npts(ptIds->GetNumberOfIds());
+    outCellLocPt[i] = outCurCellLoc;
+    *outConnPt++ = npts;
+    outConnPt = std::transform(ptIds->GetPointer(0),ptIds->GetPointer(0)+npts,outConnPt,outPointId);
+    outCellTypePt[i] = (unsigned char)ds->GetCellType(cellIds[i]);
+    outCurCellLoc += npts+1;
+    if( outFaces )
+    {
+      if( outCellTypePt[i] == VTK_POLYHEDRON )
+      {// face stream is [nbOfFaces, nbOfPtsOfFace0, pts of face0..., nbOfPtsOfFace1, ...]
+        outFaceLocations->SetValue(i,outFaces->GetNumberOfTuples());
+        ds->GetFaceStream(cellIds[i],faceStream);
+        const vtkIdType *fs(faceStream->GetPointer(0));
+        vtkIdType nbOfFaces(*fs++);
+        outFaces->InsertNextValue(nbOfFaces);
+        for( vtkIdType f = 0 ; f < nbOfFaces ; ++f )
+        {
+          vtkIdType nbOfPtsOfFace(*fs++);
+          outFaces->InsertNextValue(nbOfPtsOfFace);
+          for( vtkIdType j = 0 ; j < nbOfPtsOfFace ; ++j )
+            outFaces->InsertNextValue(outPointId(*fs++));
+        }
+      }
+      else
+        outFaceLocations->SetValue(i,-1);
+    }
+  }
+  //
+  vtkNew<vtkIdList> cellIdsList;
+  cellIdsList->SetNumberOfIds(nbOfCellIds);
+  std::copy(cellIds,cellIds+nbOfCellIds,cellIdsList->GetPointer(0));
+  GatherArrays(ds->GetCellData(),cellIdsList,ret->GetCellData());
+  if( compactPoints )
+  {
+    if( ds->GetPoints() )
+    {
+      vtkDataArray *coords(ds->GetPoints()->GetData());
+      vtkSmartPointer<vtkDataArray> outCoords;
+      outCoords.TakeReference( coords->NewInstance() );
+      outCoords->SetNumberOfComponents(coords->GetNumberOfComponents()); outCoords->SetNumberOfTuples(pointIds->GetNumberOfIds());
+      coords->GetTuples(pointIds,outCoords);
+      vtkNew<vtkPoints> outPoints;
+      outPoints->SetData(outCoords);
+      ret->SetPoints(outPoints);
+    }
+    GatherArrays(ds->GetPointData(),pointIds,ret->GetPointData());
+    for( vtkIdType i = 0 ; i < pointIds->GetNumberOfIds() ; ++i )
+      pointMap[pointIds->GetId(i)] = -1;
+  }
+  else
+  {
+    ret->SetPoints(ds->GetPoints());
+    vtkPointData *inputPointData(ds->GetPointData());
+    for( int pointFieldId = 0 ; pointFieldId < inputPointData->GetNumberOfArrays() ; ++pointFieldId )
+    {
+      vtkDataArray *array( inputPointData->GetArray(pointFieldId) );
+      if( !array )
+        continue;
+      vtkSmartPointer<vtkDataArray> outArray;
+      outArray.TakeReference( array->NewInstance() );
+      outArray->ShallowCopy(array);
+      ret->GetPointData()->AddArray(outArray);
+    }
+  }
+  //
+  vtkNew<vtkCellArray> outCellArray;
+  outCellArray->SetCells(nbOfCellIds,outNodalConn);
+  if( outFaces )
+    ret->SetCells(outCellTypes,outCellLocations,outCellArray,outFaceLocations,outFaces);
+  else
+    ret->SetCells(outCellTypes,outCellLocations,outCellArray);
+  return ret;
+}
+
 int vtkUgSelectCellIds::RequestData(vtkInformation *vtkNotUsed(request), vtkInformationVector **inputVector, vtkInformationVector *outputVector)
 {
   vtkInformation* inputInfo=inputVector[0]->GetInformationObject(0);
@@ -51,77 +206,19 @@ int vtkUgSelectCellIds::RequestData(vtkInformation *vtkNotUsed(request), vtkInfo
   }
   vtkInformation *outInfo(outputVector->GetInformationObject(0));
   vtkUnstructuredGrid *output(vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT())));
-  output->SetPoints(ds->GetPoints());
-  vtkNew<vtkCellArray> outCellArray;
-  vtkNew<vtkIdTypeArray> outConn;
-  vtkCellData *inputCellData(ds->GetCellData());
-  vtkPointData *inputPointData(ds->GetPointData());
-  // Finish the parlote : feed data arrays
-  vtkCellData *outCellData(output->GetCellData());
-  vtkPointData *outPointData(output->GetPointData());
   vtkIdType inpNbCells( ds->GetNumberOfCells() );
   vtkIdType outputNbCells( _ids->GetNumberOfTuples() );
-  vtkNew<vtkIdTypeArray> outNodalConn;
-  vtkNew<vtkUnsignedCharArray> outCellTypes;
-  outCellTypes->SetNumberOfComponents(1); outCellTypes->SetNumberOfTuples(outputNbCells);
-  vtkNew<vtkIdTypeArray> outCellLocations;
-  outCellLocations->SetNumberOfComponents(1); outCellLocations->SetNumberOfTuples(outputNbCells);
-  vtkIdType outConnLgth(0);
   for( const vtkIdType *cellId = _ids->GetPointer(0) ; cellId != _ids->GetPointer(outputNbCells) ; ++cellId )
   {
-    if( *cellId >=0 && *cellId < inpNbCells )
-    {
-      vtkIdType npts;
-      const vtkIdType *pts;
-      ds->GetCellPoints(*cellId, npts, pts);
-      outConnLgth += 1+npts;
-    }
-    else
+    if( *cellId < 0 || *cellId >= inpNbCells )
     {
       vtkErrorMacro(<< "vtkUgSelectCellIds::RequestData : presence of " << *cellId << " in array must be in [0," << inpNbCells << "[ !");
       return 0;
-    } 
-  }
-  outNodalConn->SetNumberOfComponents(1); outNodalConn->SetNumberOfTuples(outConnLgth);
-  vtkIdType *outConnPt(outNodalConn->GetPointer(0)),*outCellLocPt(outCellLocations->GetPointer(0));
-  vtkIdType outCurCellLoc = 0;
-  unsigned char *outCellTypePt(outCellTypes->GetPointer(0));
-  for( const vtkIdType *cellId = _ids->GetPointer(0) ; cellId != _ids->GetPointer(outputNbCells) ; ++cellId )
-  {
-      outCellLocPt[0] = outCurCellLoc;
-      vtkIdType npts;
-      const vtkIdType *pts;
-      ds->GetCellPoints(*cellId, npts, pts);
-      *outConnPt++ = npts;
-      outConnPt = std::copy(pts,pts+npts,outConnPt);
-      *outCellTypePt++ = ds->GetCellType(*cellId);
-      outCurCellLoc += npts+1;//not sure
-  }
-  for( int cellFieldId = 0 ; cellFieldId < inputCellData->GetNumberOfArrays() ; ++cellFieldId )
-  {
-    vtkDataArray *array( inputCellData->GetArray(cellFieldId) );
-    vtkSmartPointer<vtkDataArray> outArray;
-    outArray.TakeReference( array->NewInstance() );
-    outArray->SetNumberOfComponents(array->GetNumberOfComponents()); outArray->SetNumberOfTuples(outputNbCells);
-    outArray->SetName(array->GetName());
-    vtkIdType pos(0);
-    for( const vtkIdType *cellId = _ids->GetPointer(0) ; cellId != _ids->GetPointer(outputNbCells) ; ++cellId )
-    {
-      outArray->SetTuple(pos++,*cellId,array);
     }
-    outCellData->AddArray(outArray);
-  }
-  for( int pointFieldId = 0 ; pointFieldId < inputPointData->GetNumberOfArrays() ; ++pointFieldId )
-  {
-    vtkDataArray *array( inputPointData->GetArray(pointFieldId) );
-    vtkSmartPointer<vtkDataArray> outArray;
-    outArray.TakeReference( array->NewInstance() );
-    outArray->ShallowCopy(array);
-    outPointData->AddArray(outArray);
   }
-  //
-  outCellArray->SetCells(outputNbCells,outNodalConn);
-  output->SetCells(outCellTypes,outCellLocations,outCellArray);
-  //
+  vtkNew<vtkIdList> ptIds,faceStream;
+  std::vector<vtkIdType> pointMap;
+  vtkSmartPointer<vtkUnstructuredGrid> selection(SelectCellIds(ds,_ids->GetPointer(0),outputNbCells,_compact_points,ptIds,faceStream,pointMap));
+  output->ShallowCopy(selection);
   return 1;
 }
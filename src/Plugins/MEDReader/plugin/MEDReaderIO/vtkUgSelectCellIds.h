@@ -23,11 +23,16 @@
 #include <vtkUnstructuredGridAlgorithm.h>
 #include <vtkSmartPointer.h>
 #include <vtkIdTypeArray.h>
+#include <vtkUnstructuredGrid.h>
+
+#include <vector>
+
+class vtkIdList;
 
 /*!
  * Class taking only specified cellIds of input vtkUnstructuredGrid dataset
- * For performance reasons orphan nodes are not removed here.
- * The output vtkUnstructuredGrid is lying on the same points than input one.
+ * By default, for performance reasons orphan nodes are not removed here : the output vtkUnstructuredGrid is lying on the same points than input one.
+ * With CompactPoints, only the points of the selected cells are kept, numbered in the order of their first use.
  */
 class vtkUgSelectCellIds : public vtkUnstructuredGridAlgorithm
 {
@@ -35,10 +40,14 @@ public:
     static vtkUgSelectCellIds* New();
     vtkTypeMacro(vtkUgSelectCellIds, vtkUnstructuredGridAlgorithm)
     void SetIds(vtkIdTypeArray *ids);
+    void SetCompactPoints(bool compactPoints);
+    bool GetCompactPoints() const { return _compact_points; }
+    static vtkSmartPointer<vtkUnstructuredGrid> SelectCellIds(vtkUnstructuredGrid *ds, const vtkIdType *cellIds, vtkIdType nbOfCellIds, bool compactPoints, vtkIdList *ptIds, vtkIdList *faceStream, std::vector<vtkIdType>& pointMap);
     vtkUgSelectCellIds() = default;
     ~vtkUgSelectCellIds() override = default;
 protected:
     int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 private:
     vtkSmartPointer<vtkIdTypeArray> _ids;
+    bool _compact_points = false;
 };
@@ -23,6 +23,7 @@
 #include "vtkSMProxy.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMProperty.h"
+#include "vtkSMPropertyHelper.h"
 
 #include "pqPropertiesPanel.h"
 
@@ -86,7 +87,12 @@ void pqMEDReaderReloadWidget::buttonClicked()
   vtkSMSourceProxy::SafeDownCast(this->proxy())->UpdatePipelineInformation();
 
   // Restting properties to dufault using domains and XML values
-  this->proxy()->ResetPropertiesToDefault();
+  // except for an incremental reload that keeps the selection and the settings of the user
+  vtkSMProperty* incremental = this->proxy()->GetProperty("IncrementalReload");
+  if (!incremental || vtkSMPropertyHelper(incremental).GetAsInt() == 0)
+    {
+    this->proxy()->ResetPropertiesToDefault();
+    }
 
   if (panel)
     {
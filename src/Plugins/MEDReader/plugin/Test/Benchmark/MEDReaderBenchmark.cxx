@@ -0,0 +1,409 @@
+// Copyright (C) 2010-2021  CEA/DEN, EDF R&D
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+// Benchmark of the load path of the MEDReader. A synthetic MED file is generated, then are timed :
+//  - MEDFileFieldRepresentationTree::loadMainStructureOfFile
+//  - MEDFileFieldRepresentationTree::buildVTKInstance, for the first time step (support built) and the next ones
+//  - the time stepping through vtkMEDReader
+//  - the selection of the cells of the families of a group, as done by vtkExtractGroup, on a family array of the size of a mesh
+// Results are written in JSON, on the standard output or in the file given by --output.
+
+#include "MEDFileFieldRepresentationTree.hxx"
+#include "MEDUtilities.hxx"
+#include "ExtractGroupHelper.h"
+#include "vtkMEDReader.h"
+
+#include "MEDLoader.hxx"
+#include "MEDFileMesh.hxx"
+#include "MEDCouplingCMesh.hxx"
+#include "MEDCouplingUMesh.hxx"
+#include "MEDCouplingFieldDouble.hxx"
+#include "MEDCouplingMemArray.hxx"
+#include "InterpKernelException.hxx"
+
+#include "vtkDataSet.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace MEDCoupling;
+
+struct BenchmarkParameters
+{
+  BenchmarkParameters():_nb_of_cells(10000),_nb_of_fields(4),_nb_of_time_steps(10),_nb_of_gauss_locs(1),_nb_of_meshes(1),_nb_of_families(200),_nb_of_repeats(3),_nb_of_threads(1),_keep_file(false) { }
+  int _nb_of_cells;
+  int _nb_of_fields;
+  int _nb_of_time_steps;
+  int _nb_of_gauss_locs;
+  int _nb_of_meshes;
+  int _nb_of_families;
+  int _nb_of_repeats;
+  int _nb_of_threads;
+  bool _keep_file;
+  std::string _file_name;
+  std::string _output;
+};
+
+class BenchmarkResult
+{
+public:
+  BenchmarkResult(const std::string& name):_name(name) { }
+  void append(double seconds) { _samples.push_back(seconds); }
+  void writeJSON(std::ostream& os) const;
+private:
+  std::string _name;
+  std::vector<double> _samples;
+};
+
+void BenchmarkResult::writeJSON(std::ostream& os) const
+{
+  double mini(0.),maxi(0.),mean(0.),median(0.);
+  if(!_samples.empty())
+    {
+      std::vector<double> sorted(_samples);
+      std::sort(sorted.begin(),sorted.end());
+      mini=sorted.front(); maxi=sorted.back();
+      for(std::vector<double>::const_iterator it=sorted.begin();it!=sorted.end();it++)
+        mean+=*it;
+      mean/=(double)sorted.size();
+      median=sorted.size()%2==1?sorted[sorted.size()/2]:0.5*(sorted[sorted.size()/2-1]+sorted[sorted.size()/2]);
+    }
+  os << "    {\"name\": \"" << _name << "\", \"unit\": \"s\", \"count\": " << _samples.size() << ", \"min\": " << mini << ", \"median\": " << median;
+  os << ", \"mean\": " << mean << ", \"max\": " << maxi << ", \"samples\": [";
+  for(std::size_t i=0;i<_samples.size();i++)
+    os << (i==0?"":", ") << _samples[i];
+  os << "]}";
+}
+
+static double Elapsed(const std::chrono::steady_clock::time_point& start)
+{
+  std::chrono::duration<double> ret(std::chrono::steady_clock::now()-start);
+  return ret.count();
+}
+
+static void PrintUsage(const char *prog)
+{
+  std::cerr << "Usage : " << prog << " [options]" << std::endl;
+  std::cerr << "  --cells N        number of cells of each mesh (default 10000)" << std::endl;
+  std::cerr << "  --fields N       number of cell fields on each mesh (default 4)" << std::endl;
+  std::cerr << "  --time-steps N   number of time steps of each field (default 10)" << std::endl;
+  std::cerr << "  --gauss-locs N   number of Gauss point fields on each mesh, each with its own localization (default 1)" << std::endl;
+  std::cerr << "  --meshes N       number of meshes (default 1)" << std::endl;
+  std::cerr << "  --families N     number of families selected among 2*N by the family selection (default 200)" << std::endl;
+  std::cerr << "  --repeat N       number of repetitions of each measure (default 3)" << std::endl;
+  std::cerr << "  --threads N      number of threads used to read the fields (default 1)" << std::endl;
+  std::cerr << "  --file F         name of the MED file generated (default MEDReaderBenchmark.med in the current directory)" << std::endl;
+  std::cerr << "  --keep           keep the generated MED file" << std::endl;
+  std::cerr << "  --output F       JSON file of the results (default standard output)" << std::endl;
+}
+
+static bool ParseArguments(int argc, char *argv[], BenchmarkParameters& params)
+{
+  params._file_name="MEDReaderBenchmark.med";
+  for(int i=1;i<argc;i++)
+    {
+      std::string arg(argv[i]);
+      if(arg=="--keep")
+        {
+          params._keep_file=true;
+          continue;
+        }
+      if(i+1>=argc)
+        return false;
+      std::string val(argv[++i]);
+      if(arg=="--file")
+        params._file_name=val;
+      else if(arg=="--output")
+        params._output=val;
+      else
+        {
+          int ival(std::atoi(val.c_str()));
+          if(ival<0 || (ival==0 && arg!="--fields" && arg!="--gauss-locs"))
+            return false;
+          if(arg=="--cells")
+            params._nb_of_cells=ival;
+          else if(arg=="--fields")
+            params._nb_of_fields=ival;
+          else if(arg=="--time-steps")
+            params._nb_of_time_steps=ival;
+          else if(arg=="--gauss-locs")
+            params._nb_of_gauss_locs=ival;
+          else if(arg=="--meshes")
+            params._nb_of_meshes=ival;
+          else if(arg=="--families")
+            params._nb_of_families=ival;
+          else if(arg=="--repeat")
+            params._nb_of_repeats=ival;
+          else if(arg=="--threads")
+            params._nb_of_threads=ival;
+          else
+            return false;
+        }
+    }
+  return true;
+}
+
+/*!
+ * Quadrangles on a square grid. Gauss point fields use localizations with 1, 2, ... points along the diagonal of the reference element.
+ */
+static void GenerateFile(const BenchmarkParameters& params)
+{
+  int nbOfCellsPerDim(std::max((int)std::ceil(std::sqrt((double)params._nb_of_cells)),1));
+  for(int iMesh=0;iMesh<params._nb_of_meshes;iMesh++)
+    {
+      MCAuto<DataArrayDouble> arr(DataArrayDouble::New());
+      arr->alloc(nbOfCellsPerDim+1,1); arr->iota(0.); arr->applyLin(1./(double)nbOfCellsPerDim,(double)iMesh);
+      MCAuto<MEDCouplingCMesh> cm(MEDCouplingCMesh::New());
+      cm->setCoords(arr,arr);
+      MCAuto<MEDCouplingUMesh> m(cm->buildUnstructured());
+      std::ostringstream meshName; meshName << "mesh" << iMesh;
+      m->setName(meshName.str());
+      MCAuto<MEDFileUMesh> mm(MEDFileUMesh::New());
+      mm->setMeshAtLevel(0,m);
+      mm->write(params._file_name,iMesh==0?2:0);
+      std::size_t nbOfCells(m->getNumberOfCells());
+      for(int ts=0;ts<params._nb_of_time_steps;ts++)
+        {
+          for(int iField=0;iField<params._nb_of_fields;iField++)
+            {
+              MCAuto<MEDCouplingFieldDouble> f(MEDCouplingFieldDouble::New(ON_CELLS,ONE_TIME));
+              std::ostringstream fieldName; fieldName << "field" << iField << "_" << meshName.str();
+              f->setMesh(m); f->setName(fieldName.str()); f->setTime((double)ts,ts,0);
+              MCAuto<DataArrayDouble> vals(DataArrayDouble::New());
+              vals->alloc(nbOfCells,3); vals->iota((double)(ts+iField));
+              f->setArray(vals);
+              WriteFieldUsingAlreadyWrittenMesh(params._file_name,f);
+            }
+          for(int iLoc=0;iLoc<params._nb_of_gauss_locs;iLoc++)
+            {
+              MCAuto<MEDCouplingFieldDouble> f(MEDCouplingFieldDouble::New(ON_GAUSS_PT,ONE_TIME));
+              std::ostringstream fieldName; fieldName << "gauss" << iLoc << "_" << meshName.str();
+              f->setMesh(m); f->setName(fieldName.str()); f->setTime((double)ts,ts,0);
+              int nbOfGaussPts(iLoc+1);
+              std::vector<double> refCoo{-1.,-1.,1.,-1.,1.,1.,-1.,1.},gsCoo,w(nbOfGaussPts,4./(double)nbOfGaussPts);
+              for(int i=0;i<nbOfGaussPts;i++)
+                {
+                  double c(-1.+2.*((double)i+0.5)/(double)nbOfGaussPts);
+                  gsCoo.push_back(c); gsCoo.push_back(c);
+                }
+              f->setGaussLocalizationOnType(INTERP_KERNEL::NORM_QUAD4,refCoo,gsCoo,w);
+              MCAuto<DataArrayDouble> vals(DataArrayDouble::New());
+              vals->alloc(f->getNumberOfTuplesExpected(),1); vals->iota((double)ts);
+              f->setArray(vals);
+              WriteFieldUsingAlreadyWrittenMesh(params._file_name,f);
+            }
+        }
+    }
+}
+
+static long long FileSize(const std::string& fileName)
+{
+  std::ifstream ifs(fileName.c_str(),std::ios::binary|std::ios::ate);
+  return ifs?(long long)ifs.tellg():-1;
+}
+
+static void BenchmarkLoadStructure(const BenchmarkParameters& params, BenchmarkResult& res)
+{
+  for(int i=0;i<params._nb_of_repeats;i++)
+    {
+      MEDFileFieldRepresentationTree tree;
+      std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+      tree.loadMainStructureOfFile(params._file_name.c_str(),-1,-1);
+      res.append(Elapsed(start));
+    }
+}
+
+/*!
+ * The first time step builds the support of the leaf, next ones reuse it. The dataset cache of the tree is disabled so that every time step is read.
+ */
+static void BenchmarkBuildVTKInstance(const BenchmarkParameters& params, BenchmarkResult& first, BenchmarkResult& next, std::string& stages)
+{
+  for(int i=0;i<params._nb_of_repeats;i++)
+    {
+      MEDFileFieldRepresentationTree tree;
+      tree.setCacheSizeLimit(0);
+      tree.setNumberOfThreads(params._nb_of_threads);
+      tree.loadMainStructureOfFile(params._file_name.c_str(),-1,-1);
+      tree.activateTheFirst();
+      TimeKeeper tk(0);
+      tk.setMaxNumberOfTimeSteps(tree.getMaxNumberOfTimeSteps());
+      int lev0(-1);
+      std::vector<double> tsteps(tree.getTimeSteps(lev0,tk));
+      for(std::size_t it=0;it<tsteps.size();it++)
+        {
+          std::string meshName;
+          std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+          vtkDataSet *ds(tree.buildVTKInstance(false,tsteps[it],meshName,tk));
+          double elapsed(Elapsed(start));
+          ds->Delete();
+          if(it==0)
+            first.append(elapsed);
+          else
+            next.append(elapsed);
+        }
+      if(i==params._nb_of_repeats-1)
+        stages=tree.getTimings().getReport();
+    }
+}
+
+static void BenchmarkReader(const BenchmarkParameters& params, BenchmarkResult& info, BenchmarkResult& steps)
+{
+  for(int i=0;i<params._nb_of_repeats;i++)
+    {
+      vtkNew<vtkMEDReader> reader;
+      reader->SetFileName(params._file_name.c_str());
+      reader->GhostCellGeneratorCallForPara(0);
+      reader->SetDataSetCacheSize(0);
+      reader->SetNumberOfThreadsForFields(params._nb_of_threads);
+      std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+      reader->UpdateInformation();
+      info.append(Elapsed(start));
+      vtkInformation *outInfo(reader->GetOutputInformation(0));
+      int nbOfTS(outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()));
+      std::vector<double> tsteps(nbOfTS);
+      if(nbOfTS>0)
+        outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS(),&tsteps[0]);
+      for(std::vector<double>::const_iterator it=tsteps.begin();it!=tsteps.end();it++)
+        {
+          start=std::chrono::steady_clock::now();
+          reader->UpdateTimeStep(*it);
+          steps.append(Elapsed(start));
+        }
+    }
+}
+
+/*!
+ * Families of cells are -1, -2, ... -2*nbOfFamilies in turn, and one family over two is kept.
+ */
+static void BenchmarkFamilySelection(const BenchmarkParameters& params, BenchmarkResult& res)
+{
+  mcIdType nbOfCells(params._nb_of_cells),nbOfFamilies(2*(mcIdType)params._nb_of_families);
+  std::vector<mcIdType> famIds(nbOfCells);
+  for(mcIdType i=0;i<nbOfCells;i++)
+    famIds[i]=-(i%nbOfFamilies)-1;
+  std::set<int> idsToKeep;
+  for(mcIdType i=0;i<nbOfFamilies;i+=2)
+    idsToKeep.insert((int)(-i-1));
+  std::vector<char> mask(nbOfCells);
+  for(int i=0;i<params._nb_of_repeats;i++)
+    {
+      bool catchAll(false),catchSmth(false);
+      std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+      ExtractGroupFamilySelector selector(idsToKeep);
+      selector.select(famIds.data(),nbOfCells,mask.data(),2,catchAll,catchSmth);
+      res.append(Elapsed(start));
+      if(nbOfCells>=nbOfFamilies && (!catchAll || !catchSmth))
+        throw INTERP_KERNEL::Exception("BenchmarkFamilySelection : all the families to keep should have been found !");
+    }
+}
+
+/*!
+ * Each line of \a report is "name cumulTime lastTime cumulBytes lastBytes nbOfCalls". See MEDReaderTimings::getReport.
+ */
+static void WriteStagesJSON(std::ostream& os, const std::string& report)
+{
+  std::istringstream iss(report);
+  std::string line;
+  bool isFirst(true);
+  os << "  \"stages\": {";
+  while(std::getline(iss,line))
+    {
+      std::istringstream lss(line);
+      std::string name;
+      double cumulTime(0.),lastTime(0.),cumulBytes(0.),lastBytes(0.),nbOfCalls(0.);
+      if(!(lss >> name >> cumulTime >> lastTime >> cumulBytes >> lastBytes >> nbOfCalls))
+        continue;
+      os << (isFirst?"\n":",\n") << "    \"" << name << "\": {\"time\": " << cumulTime << ", \"bytes\": " << (long long)cumulBytes << ", \"calls\": " << (long long)nbOfCalls << "}";
+      isFirst=false;
+    }
+  os << "\n  }";
+}
+
+int main(int argc, char *argv[])
+{
+  BenchmarkParameters params;
+  if(!ParseArguments(argc,argv,params))
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  try
+    {
+      std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+      GenerateFile(params);
+      double generationTime(Elapsed(start));
+      BenchmarkResult loadStructure("loadMainStructureOfFile"),buildFirst("buildVTKInstance.firstTimeStep"),buildNext("buildVTKInstance.nextTimeSteps");
+      BenchmarkResult readerInfo("vtkMEDReader.RequestInformation"),readerSteps("vtkMEDReader.timeStep");
+      BenchmarkResult familySelection("ExtractGroupFamilySelector.select");
+      std::string stages;
+      BenchmarkLoadStructure(params,loadStructure);
+      BenchmarkBuildVTKInstance(params,buildFirst,buildNext,stages);
+      BenchmarkReader(params,readerInfo,readerSteps);
+      BenchmarkFamilySelection(params,familySelection);
+      //
+      std::ofstream ofs;
+      if(!params._output.empty())
+        {
+          ofs.open(params._output.c_str());
+          if(!ofs)
+            {
+              std::cerr << "Impossible to open " << params._output << " for writing !" << std::endl;
+              return 1;
+            }
+        }
+      std::ostream& os(params._output.empty()?std::cout:ofs);
+      os.precision(9);
+      os << "{\n  \"parameters\": {\"cells\": " << params._nb_of_cells << ", \"fields\": " << params._nb_of_fields << ", \"time_steps\": " << params._nb_of_time_steps;
+      os << ", \"gauss_locs\": " << params._nb_of_gauss_locs << ", \"meshes\": " << params._nb_of_meshes << ", \"families\": " << params._nb_of_families << ", \"repeat\": " << params._nb_of_repeats;
+      os << ", \"threads\": " << params._nb_of_threads << "},\n";
+      os << "  \"file_size\": " << FileSize(params._file_name) << ",\n  \"generation_time\": " << generationTime << ",\n";
+      os << "  \"results\": [\n";
+      loadStructure.writeJSON(os); os << ",\n";
+      buildFirst.writeJSON(os); os << ",\n";
+      buildNext.writeJSON(os); os << ",\n";
+      readerInfo.writeJSON(os); os << ",\n";
+      readerSteps.writeJSON(os); os << ",\n";
+      familySelection.writeJSON(os); os << "\n  ],\n";
+      WriteStagesJSON(os,stages);
+      os << "\n}" << std::endl;
+    }
+  catch(INTERP_KERNEL::Exception& e)
+    {
+      std::cerr << "Exception has been thrown in MEDReaderBenchmark : " << e.what() << std::endl;
+      if(!params._keep_file)
+        std::remove(params._file_name.c_str());
+      return 1;
+    }
+  if(!params._keep_file)
+    std::remove(params._file_name.c_str());
+  return 0;
+}
@@ -0,0 +1,123 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the asynchronous prefetch of the next time step in the MEDReader plugin.
+Datasets obtained with prefetch have to be bit-identical to the ones read on demand, and the next time step has to be served by the prefetch.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import numpy as np
+import medcoupling as mc
+import time
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname,nbOfTS):
+    arr = mc.DataArrayDouble(11) ; arr.iota()
+    m = mc.MEDCouplingCMesh()
+    m.setCoords(arr,arr)
+    m = m.buildUnstructured()
+    m.setName("mesh")
+    mm = mc.MEDFileUMesh()
+    mm[0] = m
+    mm.write(fname,2)
+    fmtsCell = mc.MEDFileFieldMultiTS()
+    fmtsNode = mc.MEDFileFieldMultiTS()
+    fmtsGaussNE = mc.MEDFileFieldMultiTS()
+    for i in range(nbOfTS):
+        f = mc.MEDCouplingFieldDouble(mc.ON_CELLS)
+        f.setMesh(m)
+        f.setArray(m.computeCellCenterOfMass().magnitude()*float(i+1))
+        f.setName("fieldCell") ; f.setTime(float(i)/2.,i,0)
+        fmtsCell.appendFieldNoProfileSBT(f)
+        f2 = mc.MEDCouplingFieldDouble(mc.ON_NODES)
+        f2.setMesh(m)
+        f2.setArray(m.getCoords().magnitude()+float(i))
+        f2.setName("fieldNode") ; f2.setTime(float(i)/2.,i,0)
+        fmtsNode.appendFieldNoProfileSBT(f2)
+        f3 = mc.MEDCouplingFieldDouble(mc.ON_GAUSS_NE)
+        f3.setMesh(m)
+        arr3 = mc.DataArrayDouble(4*m.getNumberOfCells(),2) ; arr3.iota(float(i))
+        arr3.setInfoOnComponents(["XX","YY"])
+        f3.setArray(arr3)
+        f3.setName("fieldGaussNE") ; f3.setTime(float(i)/2.,i,0)
+        fmtsGaussNE.appendFieldNoProfileSBT(f3)
+    fmtsCell.write(fname,0)
+    fmtsNode.write(fname,0)
+    fmtsGaussNE.write(fname,0)
+    return [float(i)/2. for i in range(nbOfTS)]
+
+def compareDataSets(ds0,ds1):
+    MyAssert(ds0.GetNumberOfCells()==ds1.GetNumberOfCells())
+    MyAssert(ds0.GetNumberOfPoints()==ds1.GetNumberOfPoints())
+    for att0,att1 in [(ds0.GetPointData(),ds1.GetPointData()),(ds0.GetCellData(),ds1.GetCellData()),(ds0.GetFieldData(),ds1.GetFieldData())]:
+        MyAssert(att0.GetNumberOfArrays()==att1.GetNumberOfArrays())
+        for i in range(att0.GetNumberOfArrays()):
+            a0 = att0.GetArray(i)
+            a1 = att1.GetArray(a0.GetName())
+            MyAssert(a1 is not None)
+            MyAssert(a0.GetDataType()==a1.GetDataType())
+            n0 = numpy_support.vtk_to_numpy(a0) ; n1 = numpy_support.vtk_to_numpy(a1)
+            MyAssert(n0.shape==n1.shape)
+            MyAssert(n0.tobytes()==n1.tobytes())# bit identical
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader23.med"
+    times = generateCase(fname,8)
+    arrays = ['TS0/mesh/ComSup0/fieldCell@@][@@P0','TS0/mesh/ComSup0/fieldNode@@][@@P1','TS0/mesh/ComSup0/fieldGaussNE@@][@@GSSNE']
+    readerRef = MEDReader(FileName=fname)
+    readerRef.AllArrays = arrays
+    readerPrefetch = MEDReader(FileName=fname)
+    readerPrefetch.AllArrays = arrays
+    readerPrefetch.PrefetchNextTimeStep = 1
+    MyAssert(list(readerPrefetch.TimestepValues)==times)
+    def play(sequence):
+        for t in sequence:
+            readerRef.UpdatePipeline(t)
+            readerPrefetch.UpdatePipeline(t)
+            compareDataSets(servermanager.Fetch(readerRef).GetBlock(0),servermanager.Fetch(readerPrefetch).GetBlock(0))
+            time.sleep(0.05)# let the background thread finish its work
+    # forward playback : each time step but the first one is served by the prefetch of the previous request
+    play(times)
+    MyAssert(readerPrefetch.GetClientSideObject().GetNumberOfPrefetchHits()==len(times)-1)
+    readerPrefetch.SMProxy.UpdatePropertyInformation()
+    MyAssert(readerPrefetch.GetProperty("PrefetchHitsInfo").GetData()==len(times)-1)
+    MyAssert(readerRef.GetClientSideObject().GetNumberOfPrefetchHits()==0)
+    # backward playback then jumps (the latter cancel the pending prefetch)
+    play(times[::-1] + [times[1],times[6],times[2],times[2],times[7]])
+    MyAssert(readerPrefetch.GetClientSideObject().GetNumberOfPrefetchHits()>len(times)-1)
+    # change of field selection while a prefetch is pending
+    readerPrefetch.UpdatePipeline(times[3])
+    readerPrefetch.AllArrays = arrays[:2]
+    readerRef.AllArrays = arrays[:2]
+    for t in times[3:6]:
+        readerRef.UpdatePipeline(t)
+        readerPrefetch.UpdatePipeline(t)
+        compareDataSets(servermanager.Fetch(readerRef).GetBlock(0),servermanager.Fetch(readerPrefetch).GetBlock(0))
+
+if __name__ == "__main__":
+    test()
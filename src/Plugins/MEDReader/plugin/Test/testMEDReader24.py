@@ -0,0 +1,135 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test and benchmark of the metadata index of the MEDReader plugin.
+Cold open (file read + index written) is compared with indexed open. The information published
+to the pipeline and the data read have to be the same with and without index.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+import os
+import time
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname,nbOfCellsPerDim,nbOfFields,nbOfTS):
+    arr = mc.DataArrayDouble(nbOfCellsPerDim+1) ; arr.iota()
+    m = mc.MEDCouplingCMesh()
+    m.setCoords(arr,arr,arr)
+    m = m.buildUnstructured()
+    m.setName("mesh")
+    mm = mc.MEDFileUMesh()
+    mm[0] = m
+    mm[-1] = m.computeSkin()
+    nbCells = m.getNumberOfCells()
+    grps = []
+    for i in range(4):
+        grp = mc.DataArrayInt.Range(i,nbCells,4) ; grp.setName("grp%d"%i)
+        grps.append(grp)
+    mm.setGroupsAtLevel(0,grps)
+    mm.write(fname,2)
+    for j in range(nbOfFields):
+        fmts = mc.MEDFileFieldMultiTS()
+        for i in range(nbOfTS):
+            f = mc.MEDCouplingFieldDouble(mc.ON_CELLS if j%2==0 else mc.ON_NODES)
+            f.setMesh(m)
+            arr2 = mc.DataArrayDouble(f.getNumberOfTuplesExpected()) ; arr2.iota(float(i+j))
+            f.setArray(arr2)
+            f.setName("field%d"%j) ; f.setTime(float(i)/4.,i,0)
+            fmts.appendFieldNoProfileSBT(f)
+        fmts.write(fname,0)
+
+def openReader(fname,useIndex,indexDir=""):
+    st = time.perf_counter()
+    reader = MEDReader(FileName=fname,UseMetadataIndex=useIndex,MetadataIndexDirectory=indexDir)
+    reader.UpdatePipelineInformation()
+    return reader,time.perf_counter()-st
+
+def publishedInfo(reader):
+    grps = ExtractGroup(Input=reader)
+    grps.UpdatePipelineInformation()
+    ret = (list(reader.GetProperty("FieldsTreeInfo")),list(reader.TimestepValues),list(grps.GetProperty("GroupsFlagsInfo")))
+    Delete(grps)
+    return ret
+
+def compareDataSets(ds0,ds1):
+    MyAssert(ds0.GetNumberOfCells()==ds1.GetNumberOfCells())
+    MyAssert(ds0.GetNumberOfPoints()==ds1.GetNumberOfPoints())
+    for att0,att1 in [(ds0.GetPointData(),ds1.GetPointData()),(ds0.GetCellData(),ds1.GetCellData())]:
+        MyAssert(att0.GetNumberOfArrays()==att1.GetNumberOfArrays())
+        for i in range(att0.GetNumberOfArrays()):
+            a0 = att0.GetArray(i)
+            a1 = att1.GetArray(a0.GetName())
+            MyAssert(a1 is not None)
+            MyAssert(numpy_support.vtk_to_numpy(a0).tobytes()==numpy_support.vtk_to_numpy(a1).tobytes())
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader24.med"
+    indexName = fname+".pvidx"
+    generateCase(fname,40,20,10)
+    #
+    readerRef,tRef = openReader(fname,0)
+    infoRef = publishedInfo(readerRef)
+    MyAssert(not os.path.exists(indexName))
+    # cold open : the file is read and the index is written
+    readerCold,tCold = openReader(fname,1)
+    MyAssert(os.path.exists(indexName))
+    MyAssert(publishedInfo(readerCold)==infoRef)
+    # indexed open
+    readerIdx,tIdx = openReader(fname,1)
+    MyAssert(publishedInfo(readerIdx)==infoRef)
+    print("Open without index : %.3f s ; cold open : %.3f s ; indexed open : %.3f s (speedup x%.1f)"%(tRef,tCold,tIdx,tCold/max(tIdx,1e-6)))
+    # the selection made before the first RequestData has to be kept when the file is really read
+    arrays = ['TS0/mesh/ComSup0/field1@@][@@P1','TS0/mesh/ComSup0/field4@@][@@P0']
+    for reader in [readerRef,readerIdx]:
+        reader.AllArrays = arrays
+    times = infoRef[1]
+    for t in [times[0],times[-1],times[3]]:
+        readerRef.UpdatePipeline(t)
+        readerIdx.UpdatePipeline(t)
+        compareDataSets(servermanager.Fetch(readerRef).GetBlock(0),servermanager.Fetch(readerIdx).GetBlock(0))
+    # an index not up to date regarding the MED file must be ignored and rewritten
+    st = os.stat(fname)
+    os.utime(fname,ns=(st.st_atime_ns,st.st_mtime_ns+10**9))
+    readerStale,tStale = openReader(fname,1)
+    MyAssert(publishedInfo(readerStale)==infoRef)
+    MyAssert(open(indexName,"rb").read().split()[3]==str(os.stat(fname).st_mtime_ns).encode())
+    # a corrupted index announcing huge counts must be ignored too
+    header = open(indexName,"rb").read().split()[:4]
+    with open(indexName,"wb") as f:
+        f.write(b" ".join(header)+b"\n"+str(2**62).encode()+b"\n")
+    readerCorrupted,tCorrupted = openReader(fname,1)
+    MyAssert(publishedInfo(readerCorrupted)==infoRef)
+    # index in a dedicated directory
+    os.mkdir("idxdir")
+    readerDir,tDir = openReader(fname,1,"idxdir")
+    MyAssert(len(os.listdir("idxdir"))==1)
+    MyAssert(publishedInfo(readerDir)==infoRef)
+
+if __name__ == "__main__":
+    test()
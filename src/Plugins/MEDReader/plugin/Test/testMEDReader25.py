@@ -0,0 +1,90 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the lazy mesh loading of the MEDReader plugin on a file with several meshes.
+Families, numbering and groups have to be the same than with the standard loading.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    for i,meshName in enumerate(["mesh0","mesh1","mesh2"]):
+        arr = mc.DataArrayDouble(4+i) ; arr.iota()
+        m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName(meshName)
+        if i==2:# several geometric types at the same level
+            tris = m[:2] ; tris.simplexize(0)
+            m = mc.MEDCouplingUMesh.MergeUMeshesOnSameCoords([tris,m[2:]]) ; m.setName(meshName)
+            m.sortCellsInMEDFileFrmt()
+        mm = mc.MEDFileUMesh() ; mm[0] = m
+        nbCells = m.getNumberOfCells()
+        grp0 = mc.DataArrayInt.Range(0,nbCells,2) ; grp0.setName("even")
+        grp1 = mc.DataArrayInt.Range(1,nbCells,2) ; grp1.setName("odd")
+        mm.setGroupsAtLevel(0,[grp0,grp1])
+        grp2 = mc.DataArrayInt.Range(0,m.getNumberOfNodes(),3) ; grp2.setName("nodes")
+        mm.setGroupsAtLevel(1,[grp2])
+        mm.setRenumFieldArr(0,mc.DataArrayInt.Range(100,100+nbCells,1))
+        mm.setRenumFieldArr(1,mc.DataArrayInt.Range(1000,1000+m.getNumberOfNodes(),1))
+        mm.write(fname,2 if i==0 else 1)
+        f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("field_%s"%meshName) ; f.setTime(0.,0,0)
+        f.setArray(m.computeCellCenterOfMass().magnitude())
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def fetchArrays(reader,leaf):
+    reader.AllArrays = [leaf]
+    ds = servermanager.Fetch(reader).GetBlock(0)
+    ret = {}
+    for att in [ds.GetCellData(),ds.GetPointData()]:
+        for i in range(att.GetNumberOfArrays()):
+            ret[att.GetArray(i).GetName()] = numpy_support.vtk_to_numpy(att.GetArray(i)).tolist()
+    return ret
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader25.med"
+    generateCase(fname)
+    readerRef = MEDReader(FileName=fname)
+    readerLazy = MEDReader(FileName=fname,LazyMeshLoading=1)
+    MyAssert(list(readerRef.GetProperty("FieldsTreeInfo"))==list(readerLazy.GetProperty("FieldsTreeInfo")))
+    for meshName in ["mesh2","mesh0","mesh1"]:
+        leaf = "TS0/%s/ComSup0/field_%s@@][@@P0"%(meshName,meshName)
+        ref = fetchArrays(readerRef,leaf)
+        lazy = fetchArrays(readerLazy,leaf)
+        MyAssert(sorted(ref.keys())==sorted(lazy.keys()))
+        for k in ["FamilyIdCell","FamilyIdNode","NumIdCell","NumIdNode"]:
+            MyAssert(k in lazy)
+        for k in ref:
+            MyAssert(ref[k]==lazy[k])
+        eg = ExtractGroup(Input=readerLazy)
+        eg.AllGroups = ["GRP_odd"]
+        ds = servermanager.Fetch(eg).GetBlock(0)
+        MyAssert(ds.GetNumberOfCells()==len(ref["FamilyIdCell"])//2)
+        Delete(eg)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,91 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Micro-benchmark of the MEDReader plugin on a file with a large number of fields.
+Selection of the arrays by name, time steps requested outside of the time series and
+Gauss fields with one localization each are exercised.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+import medcoupling as mc
+import time
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname,nbOfFields,nbOfGaussFields,nbOfTS):
+    arr = mc.DataArrayDouble(4) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    fs = mc.MEDFileFields()
+    for j in range(nbOfFields+nbOfGaussFields):
+        fmts = mc.MEDFileFieldMultiTS()
+        for i in range(nbOfTS):
+            f = mc.MEDCouplingFieldDouble(mc.ON_CELLS if j<nbOfFields else mc.ON_GAUSS_PT)
+            f.setMesh(m)
+            if j>=nbOfFields:# one localization per Gauss field
+                pos = 0.1+0.8*float(j-nbOfFields)/nbOfGaussFields
+                f.setGaussLocalizationOnType(mc.NORM_QUAD4,[-1.,-1.,1.,-1.,1.,1.,-1.,1.],[-pos,-pos,pos,pos],[0.5,0.5])
+            arr2 = mc.DataArrayDouble(f.getNumberOfTuplesExpected()) ; arr2[:] = float(i)
+            f.setArray(arr2)
+            f.setName("field%04d"%j) ; f.setTime(float(i)/4.,i,0)
+            fmts.appendFieldNoProfileSBT(f)
+        fs.pushField(fmts)
+    fs.write(fname,0)
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader26.med"
+    nbOfFields,nbOfGaussFields,nbOfTS = 3000,20,6
+    generateCase(fname,nbOfFields,nbOfGaussFields,nbOfTS)
+    reader = MEDReader(FileName=fname)
+    reader.UpdatePipelineInformation()
+    allArrays = [elt for elt in reader.GetProperty("FieldsTreeInfo")[::2] if elt.startswith("TS0/mesh/ComSup0/")]
+    MyAssert(len(allArrays)==nbOfFields+nbOfGaussFields)
+    # selection by name of all the arrays, then of half of them
+    st = time.perf_counter()
+    reader.AllArrays = allArrays
+    reader.UpdatePipelineInformation()
+    reader.AllArrays = allArrays[::2]
+    reader.UpdatePipelineInformation()
+    tSel = time.perf_counter()-st
+    reader.AllArrays = allArrays
+    # (requested time, expected time step) : exact, close to a time step, between two time steps, before and after all of them
+    times = list(reader.TimestepValues)
+    MyAssert(len(times)==nbOfTS)
+    st = time.perf_counter()
+    for timeReq,expected in [(times[2],2),(times[3]+1e-15,3),(0.3,1),(-1.,0),(100.,nbOfTS-1)]:
+        reader.UpdatePipeline(timeReq)
+        ds = servermanager.Fetch(reader).GetBlock(0)
+        cd = ds.GetCellData()
+        for name in ["field0000","field%04d"%(nbOfFields-1)]:
+            MyAssert(cd.GetArray(name).GetValue(0)==float(expected))
+        MyAssert(ds.GetFieldData().GetArray("field%04d"%(nbOfFields+nbOfGaussFields-1)).GetValue(0)==float(expected))
+        MyAssert(len([cd.GetArrayName(i) for i in range(cd.GetNumberOfArrays()) if cd.GetArrayName(i).startswith("ELGA@")])==nbOfGaussFields)
+    tData = time.perf_counter()-st
+    print("%d arrays : selection : %.3f s ; 5 time steps : %.3f s"%(len(allArrays),tSel,tData))
+
+if __name__ == "__main__":
+    test()
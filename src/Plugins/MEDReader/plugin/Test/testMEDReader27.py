@@ -0,0 +1,91 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the single precision mode of the MEDReader plugin. Coordinates and FLOAT64 fields have to be
+float32 arrays, numbering arrays int32 ones, and family arrays are unchanged so that groups still work.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import vtk
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(11) ; arr.iota() ; arr *= 0.1
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    nbCells = m.getNumberOfCells()
+    grp = mc.DataArrayInt.Range(0,nbCells,3) ; grp.setName("grp")
+    mm.setGroupsAtLevel(0,[grp])
+    mm.setRenumFieldArr(0,mc.DataArrayInt.Range(100,100+nbCells,1))
+    mm.setRenumFieldArr(1,mc.DataArrayInt.Range(1000,1000+m.getNumberOfNodes(),1))
+    mm.write(fname,2)
+    f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("cellField") ; f.setTime(0.,0,0)
+    f.setArray(m.computeCellCenterOfMass().magnitude())
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    f = mc.MEDCouplingFieldDouble(mc.ON_NODES) ; f.setMesh(m) ; f.setName("nodeField") ; f.setTime(0.,0,0)
+    f.setArray(m.getCoords().deepCopy())
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def fetch(reader):
+    return servermanager.Fetch(reader).GetBlock(0)
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader27.med"
+    generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    reader.AllArrays = ['TS0/mesh/ComSup0/cellField@@][@@P0','TS0/mesh/ComSup0/nodeField@@][@@P1']
+    reader.GenerateVectors = 1
+    ref = fetch(reader)
+    reader.SinglePrecision = 1
+    sp = fetch(reader)
+    MyAssert(sp.GetPoints().GetDataType()==vtk.VTK_FLOAT)
+    MyAssert(abs(numpy_support.vtk_to_numpy(sp.GetPoints().GetData())-numpy_support.vtk_to_numpy(ref.GetPoints().GetData())).max()<1e-6)
+    for att0,att1 in [(ref.GetCellData(),sp.GetCellData()),(ref.GetPointData(),sp.GetPointData())]:
+        MyAssert(att0.GetNumberOfArrays()==att1.GetNumberOfArrays())
+        for i in range(att0.GetNumberOfArrays()):
+            a0 = att0.GetArray(i) ; a1 = att1.GetArray(a0.GetName())
+            MyAssert(a1 is not None)
+            if a0.GetDataType()==vtk.VTK_DOUBLE:
+                MyAssert(a1.GetDataType()==vtk.VTK_FLOAT)
+                MyAssert(abs(numpy_support.vtk_to_numpy(a0)-numpy_support.vtk_to_numpy(a1)).max()<1e-6)
+            else:
+                MyAssert(numpy_support.vtk_to_numpy(a0).tolist()==numpy_support.vtk_to_numpy(a1).tolist())
+    MyAssert(sp.GetPointData().GetArray("nodeField_Vector") is not None)
+    MyAssert(sp.GetCellData().GetArray("NumIdCell").GetDataType()==vtk.VTK_INT)
+    MyAssert(sp.GetCellData().GetArray("FamilyIdCell").GetDataType()==ref.GetCellData().GetArray("FamilyIdCell").GetDataType())
+    eg = ExtractGroup(Input=reader)
+    eg.AllGroups = ["GRP_grp"]
+    MyAssert(fetch(eg).GetNumberOfCells()==34)
+    Delete(eg)
+    # back to double precision
+    reader.SinglePrecision = 0
+    MyAssert(fetch(reader).GetPoints().GetDataType()==vtk.VTK_DOUBLE)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,148 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the reuse of the ghost layer across time steps by the MEDReader in parallel.
+The ghost cells and points of each time step must carry the values of this time step, the output of a previous
+time step must be left unchanged, and the result must match the one of a reader reading directly the last time step.
+
+Run as a regular test, this script generates the case and relaunches itself on localhost with :
+  mpiexec -n 2 pvbatch --symmetric testMEDReader28.py --mpi-worker <file>
+It is skipped if mpiexec or pvbatch can't be found, or if ParaView is not built with MPI.
+"""
+
+import os,sys
+
+NB_PROCS = 2
+WORKER_OPTION = "--mpi-worker"
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    import medcoupling as mc
+    arr = mc.DataArrayDouble(21) ; arr.iota() ; arr *= 0.1
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    nbCells = m.getNumberOfCells() ; nbNodes = m.getNumberOfNodes()
+    mm.setRenumFieldArr(0,mc.DataArrayInt.Range(0,nbCells,1))
+    mm.setRenumFieldArr(1,mc.DataArrayInt.Range(0,nbNodes,1))
+    mm.write(fname,2)
+    for it in range(4):
+        f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("cellField") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayDouble(nbCells) ; a.iota(float(it)/10.) ; a *= 10.
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+        f = mc.MEDCouplingFieldDouble(mc.ON_NODES) ; f.setMesh(m) ; f.setName("nodeField") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayDouble(nbNodes) ; a.iota(1000.*it)
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def checkValues(ds,it):
+    """ cellField is 10*cellId+it and nodeField is nodeId+1000*it on local and ghost entities. """
+    from vtk.util import numpy_support
+    cellIds = numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("NumIdCell"))
+    cellField = numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("cellField"))
+    MyAssert(abs(cellField-(10.*cellIds+it)).max()<1e-10)
+    nodeIds = numpy_support.vtk_to_numpy(ds.GetPointData().GetArray("NumIdNode"))
+    nodeField = numpy_support.vtk_to_numpy(ds.GetPointData().GetArray("nodeField"))
+    MyAssert(abs(nodeField-(nodeIds+1000.*it)).max()<1e-10)
+
+def ghostArrays(ds):
+    from vtk.util import numpy_support
+    return [numpy_support.vtk_to_numpy(att.GetArray("vtkGhostType")).tolist() if att.GetArray("vtkGhostType") else [] for att in [ds.GetCellData(),ds.GetPointData()]]
+
+def worker(fname):
+    from paraview.simple import MEDReader,Delete,servermanager
+    from vtk.util import numpy_support
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    if pm.GetNumberOfLocalPartitions()!=NB_PROCS:
+        print("ParaView is not run on {} processes. Test skipped.".format(NB_PROCS))
+        return
+    allArrays = ['TS0/mesh/ComSup0/cellField@@][@@P0','TS0/mesh/ComSup0/nodeField@@][@@P1']
+    reader = MEDReader(FileName=fname)
+    reader.AllArrays = allArrays
+    reader.GhostCellGeneratorCallForPara = 1
+    times = reader.TimestepValues
+    MyAssert(len(times)==4)
+    first = None ; refGhosts = None
+    for it,t in enumerate(times):
+        reader.UpdatePipeline(t)
+        ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+        checkValues(ds,it)
+        ghosts = ghostArrays(ds)
+        MyAssert(len(ghosts[0])>0 and any(ghosts[0]))
+        if refGhosts is None:
+            refGhosts = ghosts ; first = ds
+        else:
+            MyAssert(ghosts==refGhosts)
+    # the ghost layer is computed for the first time step only
+    MyAssert(reader.GetClientSideObject().GetNumberOfGhostLayerReuses()==len(times)-1)
+    reader.SMProxy.UpdatePropertyInformation()
+    MyAssert(reader.GetProperty("GhostLayerReusesInfo").GetData()==len(times)-1)
+    # output of the first time step is not altered by the next ones
+    checkValues(first,0)
+    # same result than a reader computing the ghost layer directly for the last time step
+    reader2 = MEDReader(FileName=fname)
+    reader2.AllArrays = allArrays
+    reader2.GhostCellGeneratorCallForPara = 1
+    reader2.UpdatePipeline(times[-1])
+    ref = reader2.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    last = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    MyAssert(ref.GetNumberOfCells()==last.GetNumberOfCells() and ref.GetNumberOfPoints()==last.GetNumberOfPoints())
+    MyAssert(ghostArrays(ref)==ghostArrays(last))
+    MyAssert(reader2.GetClientSideObject().GetNumberOfGhostLayerReuses()==0)
+    for name in ["cellField","NumIdCell"]:
+        MyAssert(numpy_support.vtk_to_numpy(ref.GetCellData().GetArray(name)).tolist()==numpy_support.vtk_to_numpy(last.GetCellData().GetArray(name)).tolist())
+    for name in ["nodeField","NumIdNode"]:
+        MyAssert(numpy_support.vtk_to_numpy(ref.GetPointData().GetArray(name)).tolist()==numpy_support.vtk_to_numpy(last.GetPointData().GetArray(name)).tolist())
+    Delete(reader2) ; Delete(reader)
+    print("Rank {} OK".format(pm.GetPartitionId()))
+
+def findExecutable(name):
+    import shutil
+    binDir = os.environ.get("PARAVIEW_BIN_DIR")
+    if binDir and os.path.isfile(os.path.join(binDir,name)):
+        return os.path.join(binDir,name)
+    return shutil.which(name)
+
+def test():
+    import subprocess,tempfile
+    mpiexec = findExecutable("mpiexec") or findExecutable("mpirun")
+    pvbatch = findExecutable("pvbatch")
+    if not mpiexec or not pvbatch:
+        print("mpiexec or pvbatch not found. Test skipped.")
+        return
+    with tempfile.TemporaryDirectory() as tmpdirname:
+        fname = os.path.join(tmpdirname,"testMEDReader28.med")
+        generateCase(fname)
+        cmd = [mpiexec,"-n",str(NB_PROCS),pvbatch,"--symmetric",os.path.abspath(__file__),WORKER_OPTION,fname]
+        p = subprocess.run(cmd,stdout=subprocess.PIPE,stderr=subprocess.STDOUT)
+        out = p.stdout.decode("utf-8",errors="replace")
+        print(out)
+        MyAssert(p.returncode==0)
+        MyAssert("Test skipped" in out or all(["Rank {} OK".format(i) in out for i in range(NB_PROCS)]))
+
+if __name__ == "__main__":
+    if WORKER_OPTION in sys.argv:
+        worker(sys.argv[sys.argv.index(WORKER_OPTION)+1])
+    else:
+        test()
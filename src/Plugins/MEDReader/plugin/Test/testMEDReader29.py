@@ -0,0 +1,84 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the incremental update of the field selection of the MEDReader plugin. Only the arrays which status changed
+are pushed to the tree, and the groups exposed downstream follow the mesh of the activated arrays.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    for i,(meshName,n,grpName) in enumerate([("mesh1",4,"grpA"),("mesh2",6,"grpB")]):
+        arr = mc.DataArrayDouble(n) ; arr.iota()
+        m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName(meshName)
+        mm = mc.MEDFileUMesh() ; mm[0] = m
+        grp = mc.DataArrayInt([0,1]) ; grp.setName(grpName)
+        mm.setGroupsAtLevel(0,[grp])
+        mm.write(fname,2 if i==0 else 0)
+        for fieldName in ["f","g"]:
+            f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("{}_{}".format(fieldName,meshName)) ; f.setTime(0.,0,0)
+            f.setArray(m.computeCellCenterOfMass().magnitude())
+            mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def groups(gn):
+    gn.UpdatePipeline()
+    col = servermanager.Fetch(gn).GetBlock(0).GetColumnByName("Group Name")
+    return [col.GetValue(i) for i in range(col.GetNumberOfTuples())]
+
+def cellArrays(reader):
+    ds = servermanager.Fetch(reader).GetBlock(0)
+    return ds.GetNumberOfCells(),sorted([ds.GetCellData().GetArrayName(i) for i in range(ds.GetCellData().GetNumberOfArrays())])
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader29.med"
+    generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    reader.AllArrays = ['TS0/mesh1/ComSup0/f_mesh1@@][@@P0']
+    gn = GroupsNames(Input=reader)
+    MyAssert(groups(gn)==['grpA'])
+    nbCells,arrs = cellArrays(reader)
+    MyAssert(nbCells==9 and "f_mesh1" in arrs and "g_mesh1" not in arrs)
+    # one more array on the same mesh
+    reader.AllArrays = ['TS0/mesh1/ComSup0/f_mesh1@@][@@P0','TS0/mesh1/ComSup0/g_mesh1@@][@@P0']
+    MyAssert(groups(gn)==['grpA'])
+    nbCells,arrs = cellArrays(reader)
+    MyAssert(nbCells==9 and "f_mesh1" in arrs and "g_mesh1" in arrs)
+    # switch to the other mesh : the groups have to follow
+    reader.AllArrays = ['TS0/mesh2/ComSup0/g_mesh2@@][@@P0']
+    MyAssert(groups(gn)==['grpB'])
+    nbCells,arrs = cellArrays(reader)
+    MyAssert(nbCells==25 and "g_mesh2" in arrs and "f_mesh2" not in arrs and "f_mesh1" not in arrs)
+    # and back
+    reader.AllArrays = ['TS0/mesh1/ComSup0/g_mesh1@@][@@P0']
+    MyAssert(groups(gn)==['grpA'])
+    nbCells,arrs = cellArrays(reader)
+    MyAssert(nbCells==9 and "g_mesh1" in arrs and "f_mesh1" not in arrs)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,145 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the incremental reload of the MEDReader plugin. Time steps and fields appended to the file after its first load
+must be seen after Reload, while the mesh already loaded and the selection of the user are kept.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def buildMesh():
+    arr = mc.DataArrayDouble(5) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    return m
+
+def writeField(fname,m,fieldName,it):
+    f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName(fieldName) ; f.setTime(float(it),it,0)
+    a = mc.DataArrayDouble(m.getNumberOfCells()) ; a.iota(100.*it)
+    f.setArray(a)
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def reload(reader):
+    reader.SMProxy.GetProperty("Reload").Modified()
+    reader.SMProxy.UpdateProperty("Reload",1)
+    reader.UpdatePipelineInformation()
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader30.med"
+    m = buildMesh()
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    for it in range(2):
+        writeField(fname,m,"f",it)
+    reader = MEDReader(FileName=fname)
+    reader.IncrementalReload = 1
+    reader.AllArrays = ['TS0/mesh/ComSup0/f@@][@@P0']
+    MyAssert(len(reader.TimestepValues)==2)
+    reader.UpdatePipeline(1.)
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    MyAssert(ds.GetCellData().GetArray("f").GetTuple1(3)==103.)
+    pts = ds.GetPoints()
+    # the simulation goes on : one more time step for f and a new field g
+    writeField(fname,m,"f",2)
+    for it in range(3):
+        writeField(fname,m,"g",it)
+    reload(reader)
+    MyAssert(list(reader.TimestepValues)==[0.,1.,2.])
+    MyAssert('TS0/mesh/ComSup0/g@@][@@P0' in reader.GetProperty("FieldsTreeInfo")[::2])
+    reader.UpdatePipeline(2.)
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    MyAssert(ds.GetCellData().GetArray("f") is not None and ds.GetCellData().GetArray("g") is None)
+    MyAssert(ds.GetCellData().GetArray("f").GetTuple1(3)==203.)
+    # the mesh has not been read again
+    MyAssert(ds.GetPoints() is pts)
+    # the new field can be selected
+    reader.AllArrays = ['TS0/mesh/ComSup0/f@@][@@P0','TS0/mesh/ComSup0/g@@][@@P0']
+    reader.UpdatePipeline(2.)
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    MyAssert(ds.GetCellData().GetArray("g").GetTuple1(3)==203.)
+    # nothing changed on disk : reload is a no-op
+    reload(reader)
+    MyAssert(list(reader.TimestepValues)==[0.,1.,2.])
+    Delete(reader)
+
+@WriteInTmpDir
+def testWithCache():
+    """ datasets in cache refer to the values of the fields read before Reload : they must not be given back after it """
+    fname = "testMEDReader30_1.med"
+    m = buildMesh()
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    for it in range(2):
+        writeField(fname,m,"f",it)
+    reader = MEDReader(FileName=fname)
+    reader.IncrementalReload = 1
+    reader.DataSetCacheSize = 10
+    reader.AllArrays = ['TS0/mesh/ComSup0/f@@][@@P0']
+    for it in range(2):
+        reader.UpdatePipeline(float(it))
+    # only a time step appended : the tree keeps the same shape
+    writeField(fname,m,"f",2)
+    reload(reader)
+    MyAssert(list(reader.TimestepValues)==[0.,1.,2.])
+    for it in [0,1,2,0]:
+        reader.UpdatePipeline(float(it))
+        ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+        MyAssert(ds.GetCellData().GetArray("f").GetTuple1(3)==100.*it+3.)
+    Delete(reader)
+
+@WriteInTmpDir
+def testTimeSeriesChange():
+    """ time steps appended to one field only split the time series : the selection follows the field in its new time series """
+    fname = "testMEDReader30_2.med"
+    m = buildMesh()
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    for it in range(2):
+        writeField(fname,m,"f",it)
+        writeField(fname,m,"g",it)
+    reader = MEDReader(FileName=fname)
+    reader.IncrementalReload = 1
+    reader.AllArrays = ['TS0/mesh/ComSup0/g@@][@@P0']
+    reader.UpdatePipeline(1.)
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    MyAssert(ds.GetCellData().GetArray("g") is not None and ds.GetCellData().GetArray("f") is None)
+    writeField(fname,m,"g",2)
+    reload(reader)
+    keys = reader.GetProperty("FieldsTreeInfo")[::2]
+    MyAssert('TS0/mesh/ComSup0/g@@][@@P0' not in keys and len([elt for elt in keys if elt.endswith("/g@@][@@P0")])==1)
+    MyAssert(list(reader.TimestepValues)==[0.,1.,2.])
+    reader.UpdatePipeline(2.)
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    MyAssert(ds.GetCellData().GetArray("f") is None)
+    MyAssert(ds.GetCellData().GetArray("g").GetTuple1(3)==203.)
+    Delete(reader)
+
+if __name__ == "__main__":
+    test()
+    testWithCache()
+    testTimeSeriesChange()
@@ -0,0 +1,81 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the generation of vectors by the MEDReader plugin along time. Generated vectors carry the values of the time step
+requested, and only arrays are added : the mesh is shared between time steps so that its MTime does not change.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(6) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    for it in range(3):
+        f = mc.MEDCouplingFieldDouble(mc.ON_NODES) ; f.setMesh(m) ; f.setName("disp") ; f.setTime(float(it),it,0)
+        a = m.getCoords()*float(it+1) ; a.setInfoOnComponents(["DX","DY"])
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+        f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("stress") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayDouble(m.getNumberOfCells(),4) ; a.iota(float(it)) ; a.setInfoOnComponents(["SXX","SYY","SZZ","SXY"])
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def check(ds,it):
+    disp = numpy_support.vtk_to_numpy(ds.GetPointData().GetArray("disp"))
+    dispV = numpy_support.vtk_to_numpy(ds.GetPointData().GetArray("disp_Vector"))
+    MyAssert(dispV.shape[1]==3 and abs(dispV[:,:2]-disp).max()<1e-12 and abs(dispV[:,2]).max()==0.)
+    stress = numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("stress"))
+    stressV = numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("stress_Vector"))
+    MyAssert(stressV.shape[1]==3 and abs(stressV-stress[:,:3]).max()<1e-12 and stress[0,0]==float(it))
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader31.med"
+    generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    reader.AllArrays = ['TS0/mesh/ComSup0/disp@@][@@P1','TS0/mesh/ComSup0/stress@@][@@P0']
+    reader.GenerateVectors = 1
+    for cacheSize in [0,100]:
+        reader.DataSetCacheSize = cacheSize
+        meshMTimes = [] ; names = []
+        # twice on the time steps to use the cache when activated
+        for it in [0,1,2,0,1,2]:
+            reader.UpdatePipeline(float(it))
+            ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+            check(ds,it)
+            meshMTimes.append(ds.GetMeshMTime())
+            names.append(sorted([ds.GetPointData().GetArrayName(i) for i in range(ds.GetPointData().GetNumberOfArrays())]+[ds.GetCellData().GetArrayName(i) for i in range(ds.GetCellData().GetNumberOfArrays())]))
+        MyAssert(len(set(meshMTimes))==1)
+        MyAssert(all([elt==names[0] for elt in names]))
+    Delete(reader)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,89 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the timings of the stages of the load exposed by the MEDReader plugin, through the TimingsInfo property
+and through the field data of the output.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(11) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    for it in range(2):
+        f = mc.MEDCouplingFieldDouble(mc.ON_GAUSS_PT) ; f.setMesh(m) ; f.setName("fGauss") ; f.setTime(float(it),it,0)
+        f.setGaussLocalizationOnType(mc.NORM_QUAD4,[-1.,-1.,1.,-1.,1.,1.,-1.,1.],[-0.5,-0.5,0.5,0.5],[0.5,0.5])
+        a = mc.DataArrayDouble(2*m.getNumberOfCells()) ; a.iota(float(it))
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def parseReport(reader):
+    reader.SMProxy.UpdatePropertyInformation()
+    ret = {}
+    for line in reader.GetProperty("TimingsInfo").GetData().splitlines():
+        elts = line.split()
+        ret[elts[0]] = [float(elt) for elt in elts[1:]]
+    return ret
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader32.med"
+    generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    reader.AllArrays = ['TS0/mesh/ComSup0/fGauss@@][@@GAUSS']
+    reader.TimingsInFieldData = 1
+    for t in [0.,1.]:
+        reader.UpdatePipeline(t)
+    report = parseReport(reader)
+    MyAssert(sorted(report.keys())==sorted(["FileOpen","LoadInMemory","ArrayRead","BuildVTUArrays","ELGAOffsets","GhostCells","SIL"]))
+    # columns : cumulative time, last time, cumulative bytes, last bytes, number of calls
+    MyAssert(report["FileOpen"][4]==1 and report["LoadInMemory"][4]==1)
+    MyAssert(report["ArrayRead"][4]==2 and report["ArrayRead"][2]>=2*200*8 and report["ArrayRead"][3]>=200*8)
+    # the support is built once for both time steps
+    MyAssert(report["BuildVTUArrays"][4]==1 and report["BuildVTUArrays"][2]>0)
+    MyAssert(report["ELGAOffsets"][4]>=1)
+    for elts in report.values():
+        MyAssert(elts[0]>=elts[1]>=0. and elts[2]>=elts[3])
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    values = ds.GetFieldData().GetArray("MEDReaderTimings")
+    names = ds.GetFieldData().GetAbstractArray("MEDReaderTimingsStages")
+    MyAssert(values is not None and names is not None)
+    MyAssert(values.GetNumberOfComponents()==5 and values.GetNumberOfTuples()==names.GetNumberOfValues()==len(report))
+    for i in range(names.GetNumberOfValues()):
+        MyAssert(values.GetComponent(i,4)==report[names.GetValue(i)][4])
+    # the quadrature point filter downstream is not disturbed by the additional field data
+    gauss = ELGAfieldToPointGaussian(Input=reader)
+    gauss.SelectSourceArray = ['CELLS','ELGA@0']
+    gauss.UpdatePipeline(1.)
+    MyAssert(servermanager.Fetch(gauss).GetBlock(0).GetNumberOfPoints()==200)
+    Delete(gauss) ; Delete(reader)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,130 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the weighted partitioning of the MEDReader in parallel.
+The mesh mixes QUAD4 and TRI3 cells, with numbers of cells not multiple of the number of ranks, a SEG2 level -1 and a field
+on Gauss points having 4 points on QUAD4 and 1 on TRI3. Each rank must receive the same number of cells of each type
+(at one cell), and the load (nodes plus Gauss points of the cells) must be balanced.
+
+Run as a regular test, this script generates the case and relaunches itself on localhost with :
+  mpiexec -n 4 pvbatch --symmetric testMEDReader33.py --mpi-worker <file>
+It is skipped if mpiexec or pvbatch can't be found, or if ParaView is not built with MPI.
+"""
+
+import os,sys
+
+NB_PROCS = 4
+WORKER_OPTION = "--mpi-worker"
+# VTK cell type -> (name,number of nodes + number of Gauss points)
+WEIGHTS = {9:("QUAD4",4+4),5:("TRI3",3+1)}
+NB_CELLS = {"QUAD4":393,"TRI3":14}
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    import medcoupling as mc
+    arr = mc.DataArrayDouble(21) ; arr.iota() ; arr *= 0.1
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured()
+    m1 = m[list(range(7))] ; m1.simplexize(0)
+    m2 = m[list(range(7,m.getNumberOfCells()))]
+    m = mc.MEDCouplingUMesh.MergeUMeshesOnSameCoords(m1,m2) ; m.setName("mesh")
+    m.sortCellsInMEDFileFrmt()
+    MyAssert(m.getNumberOfCellsWithType(mc.NORM_QUAD4)==NB_CELLS["QUAD4"] and m.getNumberOfCellsWithType(mc.NORM_TRI3)==NB_CELLS["TRI3"])
+    skin = m.computeSkin() ; skin = skin[list(range(skin.getNumberOfCells()-1))]
+    mm = mc.MEDFileUMesh() ; mm[0] = m ; mm[-1] = skin
+    mm.write(fname,2)
+    f = mc.MEDCouplingFieldDouble(mc.ON_GAUSS_PT) ; f.setMesh(m) ; f.setName("gaussField") ; f.setTime(0.,0,0)
+    f.setGaussLocalizationOnType(mc.NORM_TRI3,[0.,0.,1.,0.,0.,1.],[0.333333333333333,0.333333333333333],[0.5])
+    f.setGaussLocalizationOnType(mc.NORM_QUAD4,[-1.,-1.,1.,-1.,1.,1.,-1.,1.],[-0.577350269189626,-0.577350269189626,0.577350269189626,-0.577350269189626,0.577350269189626,0.577350269189626,-0.577350269189626,0.577350269189626],[1.,1.,1.,1.])
+    a = mc.DataArrayDouble(f.getNumberOfTuplesExpected()) ; a.iota()
+    f.setArray(a) ; f.checkConsistencyLight()
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def worker(fname):
+    from paraview.simple import MEDReader,Delete,servermanager
+    from vtk.util import numpy_support
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    if pm.GetNumberOfLocalPartitions()!=NB_PROCS:
+        print("ParaView is not run on {} processes. Test skipped.".format(NB_PROCS))
+        return
+    reader = MEDReader(FileName=fname,WeightedPartitioning=1)
+    keys = [elt for elt in reader.GetProperty("FieldsTreeInfo")[::2] if "gaussField" in elt]
+    MyAssert(len(keys)==1)
+    reader.AllArrays = keys
+    reader.UpdatePipeline()
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    cellTypes = numpy_support.vtk_to_numpy(ds.GetCellTypesArray()).tolist()
+    MyAssert(set(cellTypes)<=set(WEIGHTS.keys()))
+    counts = [cellTypes.count(ct) for ct in sorted(WEIGHTS.keys())]
+    print("Rank {} cells {}".format(pm.GetPartitionId()," ".join([str(elt) for elt in counts])))
+    Delete(reader)
+    print("Rank {} OK".format(pm.GetPartitionId()))
+
+def checkBalance(out):
+    """ Each type is split at one cell among ranks, all cells are read, and the load gap is at most the weight of one cell. """
+    cts = sorted(WEIGHTS.keys())
+    counts = {}
+    for line in out.splitlines():
+        elts = line.split()
+        if len(elts)==2+len(cts) and elts[0]=="Rank" and elts[2]=="cells":
+            counts[int(elts[1])] = [int(elt) for elt in elts[3:]]
+    MyAssert(sorted(counts.keys())==list(range(NB_PROCS)))
+    for i,ct in enumerate(cts):
+        nbs = [counts[rk][i] for rk in range(NB_PROCS)]
+        MyAssert(sum(nbs)==NB_CELLS[WEIGHTS[ct][0]])
+        MyAssert(max(nbs)-min(nbs)<=1)
+    loads = [sum([counts[rk][i]*WEIGHTS[ct][1] for i,ct in enumerate(cts)]) for rk in range(NB_PROCS)]
+    MyAssert(max(loads)-min(loads)<=max([elt[1] for elt in WEIGHTS.values()]))
+
+def findExecutable(name):
+    import shutil
+    binDir = os.environ.get("PARAVIEW_BIN_DIR")
+    if binDir and os.path.isfile(os.path.join(binDir,name)):
+        return os.path.join(binDir,name)
+    return shutil.which(name)
+
+def test():
+    import subprocess,tempfile
+    mpiexec = findExecutable("mpiexec") or findExecutable("mpirun")
+    pvbatch = findExecutable("pvbatch")
+    if not mpiexec or not pvbatch:
+        print("mpiexec or pvbatch not found. Test skipped.")
+        return
+    with tempfile.TemporaryDirectory() as tmpdirname:
+        fname = os.path.join(tmpdirname,"testMEDReader33.med")
+        generateCase(fname)
+        cmd = [mpiexec,"-n",str(NB_PROCS),pvbatch,"--symmetric",os.path.abspath(__file__),WORKER_OPTION,fname]
+        p = subprocess.run(cmd,stdout=subprocess.PIPE,stderr=subprocess.STDOUT)
+        out = p.stdout.decode("utf-8",errors="replace")
+        print(out)
+        MyAssert(p.returncode==0)
+        if "Test skipped" in out:
+            return
+        MyAssert(all(["Rank {} OK".format(i) in out for i in range(NB_PROCS)]))
+        checkBalance(out)
+
+if __name__ == "__main__":
+    if WORKER_OPTION in sys.argv:
+        worker(sys.argv[sys.argv.index(WORKER_OPTION)+1])
+    else:
+        test()
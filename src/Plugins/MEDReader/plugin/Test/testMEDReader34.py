@@ -0,0 +1,80 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the sharing of the coordinates of structured meshes by the MEDReader plugin. Two leaves lying on the same 2D curvilinear
+(resp. cartesian) mesh must output the same points (resp. axes) array, padded with 0. for the curvilinear mesh.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arrX = mc.DataArrayDouble(5) ; arrX.iota() ; arrY = mc.DataArrayDouble(4) ; arrY.iota() ; arrY *= 0.5
+    cm = mc.MEDCouplingCMesh() ; cm.setCoords(arrX,arrY) ; cm.setName("cmesh")
+    clm = mc.MEDCouplingCurveLinearMesh() ; clm.setName("clmesh")
+    coords = cm.buildUnstructured().getCoords().deepCopy() ; coords[:,1] += coords[:,0]*0.1
+    clm.setCoords(coords) ; clm.setNodeGridStructure([5,4])
+    mm = mc.MEDFileCMesh() ; mm.setMesh(cm) ; mm.write(fname,2)
+    mm = mc.MEDFileCurveLinearMesh() ; mm.setMesh(clm) ; mm.write(fname,0)
+    # fields with different time steps lie in different leaves of the same mesh
+    for m in [cm,clm]:
+        for name,nbOfTS in [("A",1),("B",2)]:
+            for it in range(nbOfTS):
+                f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName(m.getName()+name) ; f.setTime(float(it),it,0)
+                a = mc.DataArrayDouble(m.getNumberOfCells()) ; a.iota(float(it))
+                f.setArray(a)
+                mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    return coords
+
+def fetch(reader,fieldName):
+    keys = [elt for elt in reader.GetProperty("FieldsTreeInfo")[::2] if elt.split("/")[-1].startswith(fieldName+"@@")]
+    MyAssert(len(keys)==1)
+    reader.AllArrays = keys
+    reader.UpdatePipeline()
+    return reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader34.med"
+    coords = generateCase(fname)
+    for singlePrecision in [0,1]:
+        reader = MEDReader(FileName=fname,SinglePrecision=singlePrecision)
+        dsA = fetch(reader,"clmeshA") ; dsB = fetch(reader,"clmeshB")
+        MyAssert(dsA.IsA("vtkStructuredGrid") and dsB.IsA("vtkStructuredGrid"))
+        MyAssert(dsA.GetPoints().GetData() is dsB.GetPoints().GetData())
+        pts = numpy_support.vtk_to_numpy(dsB.GetPoints().GetData())
+        MyAssert(pts.shape==(20,3) and abs(pts[:,:2]-coords.toNumPyArray()).max()<1e-6 and abs(pts[:,2]).max()==0.)
+        dsA = fetch(reader,"cmeshA") ; dsB = fetch(reader,"cmeshB")
+        MyAssert(dsA.IsA("vtkRectilinearGrid") and dsB.IsA("vtkRectilinearGrid"))
+        MyAssert(dsA.GetXCoordinates() is dsB.GetXCoordinates() and dsA.GetYCoordinates() is dsB.GetYCoordinates())
+        MyAssert(numpy_support.vtk_to_numpy(dsB.GetYCoordinates()).tolist()==[0.,0.5,1.,1.5])
+        MyAssert(list(dsB.GetDimensions())==[5,4,1])
+        Delete(reader)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,98 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the restriction of the read of the MEDReader plugin to some geometric types. Only the cells of the types requested,
+and the values of the fields on them, must be read and output.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+NB_TRI3 = 2*30 # 30 first squares split in 2 triangles
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(21) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured()
+    m1 = m[list(range(NB_TRI3//2))] ; m1.simplexize(0)
+    m2 = m[list(range(NB_TRI3//2,m.getNumberOfCells()))]
+    m = mc.MEDCouplingUMesh.MergeUMeshesOnSameCoords(m1,m2) ; m.setName("mesh")
+    m.sortCellsInMEDFileFrmt()
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    # cellField is x+1000*y of the barycenter, nodeField is x+1000*y of the node
+    f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("cellField") ; f.setTime(0.,0,0)
+    bary = m.computeCellCenterOfMass()
+    f.setArray(bary[:,0]+1000.*bary[:,1])
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    f = mc.MEDCouplingFieldDouble(mc.ON_NODES) ; f.setMesh(m) ; f.setName("nodeField") ; f.setTime(0.,0,0)
+    coo = m.getCoords()
+    f.setArray(coo[:,0]+1000.*coo[:,1])
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    return m
+
+def load(fname,geoTypes):
+    reader = MEDReader(FileName=fname,GeoTypesToLoad=geoTypes,TimingsInFieldData=1)
+    keys = reader.GetProperty("FieldsTreeInfo")[::2]
+    cellKeys = [elt for elt in keys if elt.split("/")[-1].startswith("cellField@@")]
+    MyAssert(len(cellKeys)==1)
+    leaf = cellKeys[0][:cellKeys[0].rfind("/")]
+    reader.AllArrays = [elt for elt in keys if elt.startswith(leaf+"/")]
+    reader.UpdatePipeline()
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    # cumulative bytes of the ArrayRead stage
+    values = ds.GetFieldData().GetArray("MEDReaderTimings") ; names = ds.GetFieldData().GetAbstractArray("MEDReaderTimingsStages")
+    bytesRead = [values.GetComponent(i,2) for i in range(names.GetNumberOfValues()) if names.GetValue(i)=="ArrayRead"][0]
+    return reader,ds,bytesRead
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader35.med"
+    m = generateCase(fname)
+    readerAll,dsAll,bytesAll = load(fname,"")
+    MyAssert(dsAll.GetNumberOfCells()==m.getNumberOfCells())
+    readerQuad,dsQuad,bytesQuad = load(fname,"QUAD4")
+    nbQuad4 = m.getNumberOfCellsWithType(mc.NORM_QUAD4)
+    cellTypes = numpy_support.vtk_to_numpy(dsQuad.GetCellTypesArray())
+    MyAssert(dsQuad.GetNumberOfCells()==nbQuad4 and (cellTypes==9).all())
+    # nodes not used by the QUAD4 cells are not read
+    MyAssert(dsQuad.GetNumberOfPoints()<dsAll.GetNumberOfPoints())
+    pts = numpy_support.vtk_to_numpy(dsQuad.GetPoints().GetData())
+    nodeField = numpy_support.vtk_to_numpy(dsQuad.GetPointData().GetArray("nodeField"))
+    MyAssert(abs(nodeField-(pts[:,0]+1000.*pts[:,1])).max()<1e-10)
+    cellField = numpy_support.vtk_to_numpy(dsQuad.GetCellData().GetArray("cellField"))
+    bary = m[list(range(NB_TRI3,m.getNumberOfCells()))].computeCellCenterOfMass()
+    MyAssert(len(cellField)==nbQuad4 and abs(cellField-(bary[:,0]+1000.*bary[:,1]).toNumPyArray().ravel()).max()<1e-10)
+    # values of the TRI3 cells are not read
+    MyAssert(0<bytesQuad<bytesAll)
+    readerTri,dsTri,bytesTri = load(fname,"NORM_TRI3")
+    MyAssert(dsTri.GetNumberOfCells()==NB_TRI3)
+    for reader in [readerAll,readerQuad,readerTri]:
+        Delete(reader)
+
+if __name__ == "__main__":
+    test()
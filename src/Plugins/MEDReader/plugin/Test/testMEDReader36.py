@@ -0,0 +1,108 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the structure of the tree of the MEDReader plugin on a file with many meshes, each one having only some of the
+time series and of the spatial discretizations. Time series, meshes and common supports without array must not appear :
+their indices are contiguous, the SIL has no vertex for them and every leaf can be loaded.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+import medcoupling as mc
+import vtk
+from MEDReaderHelper import WriteInTmpDir
+
+NB_MESHES = 12
+NB_TIME_SERIES = 4
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(4) ; arr.iota()
+    for i in range(NB_MESHES):
+        m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr+float(i)) ; m = m.buildUnstructured() ; m.setName("mesh{}".format(i))
+        mm = mc.MEDFileUMesh() ; mm[0] = m
+        mm.write(fname,2 if i==0 else 0)
+        # time series i%NB_TIME_SERIES has i%NB_TIME_SERIES+1 time steps, on cells for even meshes and on nodes for the others
+        nbOfTS = i%NB_TIME_SERIES+1
+        for it in range(nbOfTS):
+            tof = mc.ON_CELLS if i%2==0 else mc.ON_NODES
+            f = mc.MEDCouplingFieldDouble(tof) ; f.setMesh(m) ; f.setName("f{}".format(i)) ; f.setTime(float(it),it,0)
+            a = mc.DataArrayDouble(m.getNumberOfCells() if tof==mc.ON_CELLS else m.getNumberOfNodes()) ; a.iota(float(it))
+            f.setArray(a)
+            mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def checkContiguous(indices):
+    MyAssert(sorted(set(indices))==list(range(len(set(indices)))))
+
+def children(sil,names,v):
+    return [(sil.GetChild(v,i),names.GetValue(sil.GetChild(v,i))) for i in range(sil.GetNumberOfChildren(v))]
+
+def supportsInSIL(reader):
+    """ Returns the TSn/mesh/ComSupk paths of the SIL, and the number of arrays below each of them. """
+    sil = vtk.vtkMutableDirectedGraph()
+    reader.GetClientSideObject().BuildSIL(sil)
+    names = sil.GetVertexData().GetAbstractArray("Names")
+    fieldsRoot = [v for v,name in children(sil,names,0) if name=="FieldsStatusTree"][0]
+    ret = {}
+    for tsId,tsName in children(sil,names,fieldsRoot):
+        if not tsName.startswith("TS"):
+            continue
+        for meshId,meshName in children(sil,names,tsId):
+            for comSupId,comSupName in children(sil,names,meshId):
+                arrs = [v for v,name in children(sil,names,comSupId) if name=="Arrs"]
+                MyAssert(len(arrs)==1)
+                ret["/".join([tsName,meshName,comSupName])] = sil.GetNumberOfChildren(arrs[0])
+    return ret
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader36.med"
+    generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    keys = reader.GetProperty("FieldsTreeInfo")[::2]
+    paths = [elt.split("/") for elt in keys]
+    MyAssert(all([len(elt)==4 for elt in paths]))
+    checkContiguous([int(elt[0][2:]) for elt in paths])
+    for ts in set([elt[0] for elt in paths]):
+        for mesh in set([elt[1] for elt in paths if elt[0]==ts]):
+            checkContiguous([int(elt[2][6:]) for elt in paths if elt[0]==ts and elt[1]==mesh])
+    # one time series per number of time steps, each mesh in a single time series with a single support holding its field
+    supports = supportsInSIL(reader)
+    MyAssert(len(set([elt[0] for elt in paths]))==NB_TIME_SERIES)
+    MyAssert(len(supports)==NB_MESHES)
+    MyAssert(sorted(supports.keys())==sorted(set(["/".join(elt[:3]) for elt in paths])))
+    MyAssert(all([nb==1 for nb in supports.values()]))
+    # each field is in a single leaf, and every leaf can be loaded
+    for i in range(NB_MESHES):
+        fKeys = [elt for elt in keys if elt.split("/")[-1].startswith("f{}@@".format(i))]
+        MyAssert(len(fKeys)==1 and fKeys[0].split("/")[1]=="mesh{}".format(i))
+        reader.AllArrays = fKeys
+        reader.UpdatePipeline()
+        ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+        att = ds.GetCellData() if i%2==0 else ds.GetPointData()
+        MyAssert(att.GetArray("f{}".format(i)) is not None)
+    Delete(reader)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,112 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the extraction of the cells by ExtractGroup. The output has to be exactly the one of vtkThreshold applied on the
+selection of the families : same points in the same order, same cells, same face streams of polyhedra and same arrays.
+Groups on cells and on nodes are tested, with and without InsideOut.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import vtk
+import numpy as np
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(5) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    m.convertToPolyTypes(mc.DataArrayInt.Range(m.getNumberOfCells()-15,m.getNumberOfCells(),1)) # polyhedra after hexahedra, as in MED files
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    nbCells = m.getNumberOfCells() ; nbNodes = m.getNumberOfNodes()
+    grp0 = mc.DataArrayInt.Range(0,nbCells,3) ; grp0.setName("cells3")
+    grp1 = mc.DataArrayInt.Range(nbCells//2,nbCells,1) ; grp1.setName("upper")
+    mm.setGroupsAtLevel(0,[grp0,grp1])
+    grp2 = mc.DataArrayInt.Range(0,nbNodes//2,1) ; grp2.setName("lowerNodes")
+    mm.setGroupsAtLevel(1,[grp2])
+    mm.write(fname,2)
+    f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("fieldCell") ; f.setTime(0.,0,0)
+    f.setArray(m.computeCellCenterOfMass())
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    f = mc.MEDCouplingFieldDouble(mc.ON_NODES) ; f.setMesh(m) ; f.setName("fieldNode") ; f.setTime(0.,0,0)
+    f.setArray(m.getCoords().magnitude())
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    return mm
+
+def thresholdOfFamilies(ds,famIds,onPoints,insideOut):
+    """ What ExtractGroup used to do : vtkThreshold on a selection array. """
+    ref = ds.NewInstance() ; ref.ShallowCopy(ds)
+    att = ref.GetPointData() if onPoints else ref.GetCellData()
+    fams = numpy_support.vtk_to_numpy(att.GetArray("FamilyIdNode" if onPoints else "FamilyIdCell"))
+    sel = numpy_support.numpy_to_vtk(np.array([2 if fam in famIds else 0 for fam in fams],dtype=np.int8),deep=1,array_type=vtk.VTK_CHAR)
+    sel.SetName("@@ZeSelection@@")
+    att.AddArray(sel)
+    thres = vtk.vtkThreshold()
+    thres.SetInputData(ref)
+    thres.SetInputArrayToProcess(0,0,0,vtk.vtkDataObject.FIELD_ASSOCIATION_POINTS if onPoints else vtk.vtkDataObject.FIELD_ASSOCIATION_CELLS,"@@ZeSelection@@")
+    thres.ThresholdBetween(0. if insideOut else 1.,1. if insideOut else 2.)
+    thres.Update()
+    ret = thres.GetOutput()
+    (ret.GetPointData() if onPoints else ret.GetCellData()).RemoveArray("@@ZeSelection@@")
+    return ret
+
+def toList(arr):
+    return numpy_support.vtk_to_numpy(arr).tolist() if arr else None
+
+def checkSame(ds,ref):
+    MyAssert(ds.GetNumberOfCells()==ref.GetNumberOfCells())
+    MyAssert(ds.GetNumberOfPoints()==ref.GetNumberOfPoints())
+    MyAssert(toList(ds.GetPoints().GetData())==toList(ref.GetPoints().GetData()))
+    MyAssert(toList(ds.GetCells().GetData())==toList(ref.GetCells().GetData()))
+    MyAssert(toList(ds.GetCellTypesArray())==toList(ref.GetCellTypesArray()))
+    MyAssert(toList(ds.GetFaces())==toList(ref.GetFaces()))
+    for attDs,attRef in [(ds.GetCellData(),ref.GetCellData()),(ds.GetPointData(),ref.GetPointData())]:
+        MyAssert(sorted([attDs.GetArrayName(i) for i in range(attDs.GetNumberOfArrays())])==sorted([attRef.GetArrayName(i) for i in range(attRef.GetNumberOfArrays())]))
+        for i in range(attRef.GetNumberOfArrays()):
+            name = attRef.GetArrayName(i)
+            MyAssert(toList(attDs.GetArray(name))==toList(attRef.GetArray(name)))
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader37.med"
+    mm = generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    reader.AllArrays = ["TS0/mesh/ComSup0/fieldCell@@][@@P0","TS0/mesh/ComSup0/fieldNode@@][@@P1"]
+    ds = servermanager.Fetch(reader).GetBlock(0)
+    MyAssert(ds.GetFaces() is not None)
+    for grpName,onPoints in [("cells3",False),("upper",False),("lowerNodes",True)]:
+        for insideOut in [0,1]:
+            eg = ExtractGroup(Input=reader)
+            eg.AllGroups = ["GRP_%s"%grpName]
+            eg.InsideOut = insideOut
+            out = servermanager.Fetch(eg).GetBlock(0)
+            ref = thresholdOfFamilies(ds,set(mm.getFamiliesIdsOnGroup(grpName)),onPoints,insideOut)
+            MyAssert(out.GetNumberOfCells()>0)
+            checkSame(out,ref)
+            Delete(eg)
+
+if __name__ == "__main__":
+    test()
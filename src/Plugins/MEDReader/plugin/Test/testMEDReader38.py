@@ -0,0 +1,74 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+__doc__ = """
+Test of ExtractGroup over the time steps of a field on a fixed mesh. The extraction of the mesh is done once : the points
+of the output are shared by all the time steps, whereas the field values follow the time steps. Changing the selection
+must give a new extraction.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+NB_TIME_STEPS = 3
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(7) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    nbCells = m.getNumberOfCells()
+    grp0 = mc.DataArrayInt.Range(0,nbCells,4) ; grp0.setName("grp0")
+    grp1 = mc.DataArrayInt.Range(1,nbCells,2) ; grp1.setName("grp1")
+    mm.setGroupsAtLevel(0,[grp0,grp1])
+    mm.write(fname,2)
+    for it in range(NB_TIME_STEPS):
+        f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("field") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayDouble(nbCells) ; a.iota(100.*it)
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    return nbCells
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader38.med"
+    nbCells = generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    eg = ExtractGroup(Input=reader)
+    for grpName,cellIds in [("grp0",range(0,nbCells,4)),("grp1",range(1,nbCells,2))]:
+        eg.AllGroups = ["GRP_%s"%grpName]
+        pts = None
+        for it in range(NB_TIME_STEPS):
+            eg.UpdatePipeline(float(it))
+            ds = eg.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+            MyAssert(ds.GetNumberOfCells()==len(cellIds))
+            MyAssert(numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("field")).tolist()==[100.*it+i for i in cellIds])
+            if pts is None:
+                pts = ds.GetPoints().GetData()
+            MyAssert(ds.GetPoints().GetData() is pts)
+        MyAssert(pts.GetNumberOfTuples()==ds.GetNumberOfPoints())
+
+if __name__ == "__main__":
+    test()
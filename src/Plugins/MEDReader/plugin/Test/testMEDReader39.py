@@ -0,0 +1,98 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+__doc__ = """
+Test of GroupsAsMultiBlocks filter in the MEDReader plugin with many overlapping groups : a family lies on several groups
+and each block has to contain, in increasing order, all the cells of its group. Polyhedra keep their faces.
+With CompactPoints, each block only keeps the points of its cells.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import vtk
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+NB_GROUPS = 30
+NB_POLYH = 20
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(6) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    m.convertToPolyTypes(mc.DataArrayInt.Range(m.getNumberOfCells()-NB_POLYH,m.getNumberOfCells(),1)) # polyhedra after hexahedra, as in MED files
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    nbCells = m.getNumberOfCells()
+    grps = []
+    for i in range(NB_GROUPS):
+        grp = mc.DataArrayInt([j for j in range(nbCells) if j%(i+2)==0 or j%(NB_GROUPS+1)==i]) ; grp.setName("grp%02d"%i)
+        grps.append(grp)
+    mm.setGroupsAtLevel(0,grps)
+    mm.write(fname,2)
+    f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("field") ; f.setTime(0.,0,0)
+    a = mc.DataArrayDouble(nbCells) ; a.iota()
+    f.setArray(a)
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    return m,grps
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader39.med"
+    m,grps = generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    reader.AllArrays = ['TS0/mesh/ComSup0/field@@][@@P0']
+    groupsAsMultiBlocks = GroupsAsMultiBlocks(Input=reader)
+    groupsAsMultiBlocks.UpdatePipeline()
+    blocks = servermanager.Fetch(groupsAsMultiBlocks)
+    MyAssert(blocks.GetNumberOfBlocks()==NB_GROUPS)
+    for i,grp in enumerate(grps):
+        ds = blocks.GetBlock(i)
+        MyAssert(ds.GetNumberOfCells()==len(grp))
+        MyAssert(ds.GetNumberOfPoints()==m.getNumberOfNodes())
+        MyAssert(numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("field")).tolist()==[float(elt) for elt in grp.getValues()])
+        nbPolyh = len([elt for elt in grp.getValues() if elt>=m.getNumberOfCells()-NB_POLYH])
+        MyAssert(len([j for j in range(ds.GetNumberOfCells()) if ds.GetCellType(j)==vtk.VTK_POLYHEDRON])==nbPolyh)
+        for j in range(ds.GetNumberOfCells()):
+            if ds.GetCellType(j)==vtk.VTK_POLYHEDRON:
+                MyAssert(ds.GetCell(j).GetNumberOfFaces()==6)
+    # compaction of the points of each block
+    groupsAsMultiBlocks.CompactPoints = 1
+    groupsAsMultiBlocks.UpdatePipeline()
+    blocks = servermanager.Fetch(groupsAsMultiBlocks)
+    MyAssert(blocks.GetNumberOfBlocks()==NB_GROUPS)
+    centers = m.computeCellCenterOfMass()
+    for i,grp in enumerate(grps):
+        ds = blocks.GetBlock(i)
+        MyAssert(ds.GetNumberOfCells()==len(grp))
+        MyAssert(ds.GetNumberOfPoints()==len(m[grp].computeFetchedNodeIds()))
+        MyAssert(numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("field")).tolist()==[float(elt) for elt in grp.getValues()])
+        pts = numpy_support.vtk_to_numpy(ds.GetPoints().GetData())
+        for j,cellId in enumerate(grp.getValues()):
+            if ds.GetCellType(j)==vtk.VTK_POLYHEDRON:
+                continue
+            ptIds = vtk.vtkIdList() ; ds.GetCellPoints(j,ptIds)
+            center = pts[[ptIds.GetId(k) for k in range(ptIds.GetNumberOfIds())]].mean(axis=0)
+            MyAssert(abs(center-centers[cellId].getValues()).max()<1e-12)
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,97 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the concurrent load of the fields of a time step (NumberOfThreadsForFields). The output, including the ELGA and ELNO
+offsets and their names, must be the same than the one of the sequential load, in double and in single precision.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+import medcoupling as mc
+from vtk.util import numpy_support
+from vtk import vtkQuadratureSchemeDefinition
+from MEDReaderHelper import WriteInTmpDir
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(21) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    mm.write(fname,2)
+    nbCells = m.getNumberOfCells() ; nbNodes = m.getNumberOfNodes()
+    for it in range(2):
+        for i,nbPts in enumerate([1,4]):
+            f = mc.MEDCouplingFieldDouble(mc.ON_GAUSS_PT) ; f.setMesh(m) ; f.setName("fGauss%d"%i) ; f.setTime(float(it),it,0)
+            gsCoords = [0.,0.] if nbPts==1 else [-0.5,-0.5,0.5,-0.5,0.5,0.5,-0.5,0.5]
+            f.setGaussLocalizationOnType(mc.NORM_QUAD4,[-1.,-1.,1.,-1.,1.,1.,-1.,1.],gsCoords,nbPts*[4./nbPts])
+            a = mc.DataArrayDouble(nbPts*nbCells) ; a.iota(float(100*i+it))
+            f.setArray(a)
+            mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+        f = mc.MEDCouplingFieldDouble(mc.ON_GAUSS_NE) ; f.setMesh(m) ; f.setName("fELNO") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayDouble(4*nbCells,2) ; a.iota(float(it)) ; a.setInfoOnComponents(["X","Y"])
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+        f = mc.MEDCouplingFieldDouble(mc.ON_NODES) ; f.setMesh(m) ; f.setName("fNode") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayDouble(nbNodes) ; a.iota(float(it))
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+        f = mc.MEDCouplingFieldInt(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("fInt") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayInt(nbCells) ; a.iota(it)
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def dump(ds):
+    """ name, values and offsets array name of each array of each attribute of ds """
+    ret = []
+    for att in [ds.GetPointData(),ds.GetCellData(),ds.GetFieldData()]:
+        for i in range(att.GetNumberOfArrays()):
+            a = att.GetArray(i)
+            offsetsName = a.GetInformation().Get(vtkQuadratureSchemeDefinition.QUADRATURE_OFFSET_ARRAY_NAME())
+            ret.append((a.GetName(),a.GetDataTypeAsString(),numpy_support.vtk_to_numpy(a).tolist(),offsetsName))
+    return sorted(ret)
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader40.med"
+    generateCase(fname)
+    allArrays = ['TS0/mesh/ComSup0/fGauss0@@][@@GAUSS','TS0/mesh/ComSup0/fGauss1@@][@@GAUSS','TS0/mesh/ComSup0/fELNO@@][@@GSSNE',
+                 'TS0/mesh/ComSup0/fNode@@][@@P1','TS0/mesh/ComSup0/fInt@@][@@P0']
+    for singlePrecision in [0,1]:
+        dumps = []
+        for nbOfThreads in [1,4]:
+            reader = MEDReader(FileName=fname)
+            reader.AllArrays = allArrays
+            reader.SinglePrecision = singlePrecision
+            reader.NumberOfThreadsForFields = nbOfThreads
+            dumps.append([])
+            for t in [0.,1.,0.]:
+                reader.UpdatePipeline(t)
+                dumps[-1].append(dump(reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)))
+            Delete(reader)
+        MyAssert(dumps[0]==dumps[1])
+        names = [elt[0] for elt in dumps[0][0]]
+        MyAssert(all([name in names for name in ["fGauss0","fGauss1","fELNO","fNode","fInt","ELGA@0","ELNO@fELNO"]]))
+
+if __name__ == "__main__":
+    test()
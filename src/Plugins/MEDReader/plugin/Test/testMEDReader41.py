@@ -0,0 +1,93 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the cache of datasets of the MEDReader plugin. Going back to a time step in cache is a hit returning the same arrays
+than a read on demand. Only the arrays owned by an entry are accounted : the families and the numbers, shared by all the time steps,
+are not, so that a budget smaller than them still keeps the fields of all the time steps.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+NB_OF_TS = 2
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(201) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    nbCells = m.getNumberOfCells() ; nbNodes = m.getNumberOfNodes()
+    grp0 = mc.DataArrayInt.Range(0,nbCells,2) ; grp0.setName("even")
+    mm.setGroupsAtLevel(0,[grp0])
+    grp1 = mc.DataArrayInt.Range(0,nbNodes,2) ; grp1.setName("evenNodes")
+    mm.setGroupsAtLevel(1,[grp1])
+    mm.setRenumFieldArr(0,mc.DataArrayInt.Range(1,nbCells+1,1))
+    mm.setRenumFieldArr(1,mc.DataArrayInt.Range(1,nbNodes+1,1))
+    mm.write(fname,2)
+    for it in range(NB_OF_TS):
+        f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("field") ; f.setTime(float(it),it,0)
+        a = mc.DataArrayDouble(nbCells) ; a.iota(float(it))
+        f.setArray(a)
+        mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def fetchArrays(reader,t):
+    reader.UpdatePipeline(t)
+    ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+    ret = {}
+    for att in [ds.GetCellData(),ds.GetPointData()]:
+        for i in range(att.GetNumberOfArrays()):
+            ret[att.GetArray(i).GetName()] = numpy_support.vtk_to_numpy(att.GetArray(i)).tobytes()
+    return ret
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader41.med"
+    generateCase(fname)
+    times = [float(it) for it in range(NB_OF_TS)]
+    readerRef = MEDReader(FileName=fname)
+    reader = MEDReader(FileName=fname)
+    # the families and the numbers of cells and nodes take more than 1 MB, the field of each time step about 300 kB
+    reader.DataSetCacheSize = 1
+    for t in times:
+        ref = fetchArrays(readerRef,t)
+        MyAssert(all([k in ref for k in ["FamilyIdCell","NumIdCell","FamilyIdNode","NumIdNode","field"]]))
+        MyAssert(fetchArrays(reader,t)==ref)
+    client = reader.GetClientSideObject()
+    MyAssert(client.GetNumberOfDataSetCacheHits()==0 and client.GetNumberOfDataSetCacheMisses()==NB_OF_TS)
+    # going back to the time steps already read is served by the cache
+    for t in times:
+        MyAssert(fetchArrays(reader,t)==fetchArrays(readerRef,t))
+    MyAssert(client.GetNumberOfDataSetCacheHits()==NB_OF_TS and client.GetNumberOfDataSetCacheMisses()==NB_OF_TS)
+    reader.SMProxy.UpdatePropertyInformation()
+    MyAssert(reader.GetProperty("DataSetCacheHitsInfo").GetData()==NB_OF_TS)
+    MyAssert(reader.GetProperty("DataSetCacheMissesInfo").GetData()==NB_OF_TS)
+    # the cache is not used by the reader without budget
+    MyAssert(readerRef.GetClientSideObject().GetNumberOfDataSetCacheHits()==0 and readerRef.GetClientSideObject().GetNumberOfDataSetCacheMisses()==0)
+    Delete(reader) ; Delete(readerRef)
+
+if __name__ == "__main__":
+    test()
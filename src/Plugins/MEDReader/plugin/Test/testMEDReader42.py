@@ -0,0 +1,101 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of the reuse of the support of a leaf by the MEDReader plugin on unstructured, cartesian and curvilinear meshes.
+The geometry built for the first time step is shared by the datasets of all the time steps, whose mesh MTime does not change,
+and only the fields of the time step requested are attached to them.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+NB_OF_TS = 3
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(5) ; arr.iota()
+    cm = mc.MEDCouplingCMesh() ; cm.setCoords(arr,arr) ; cm.setName("cmesh")
+    um = cm.buildUnstructured() ; um.setName("umesh")
+    clm = mc.MEDCouplingCurveLinearMesh() ; clm.setCoords(um.getCoords()) ; clm.setNodeGridStructure([5,5]) ; clm.setName("clmesh")
+    mmu = mc.MEDFileUMesh() ; mmu[0] = um
+    mmc = mc.MEDFileCMesh() ; mmc.setMesh(cm)
+    mmcl = mc.MEDFileCurveLinearMesh() ; mmcl.setMesh(clm)
+    for i,mm in enumerate([mmu,mmc,mmcl]):
+        mm.write(fname,2 if i==0 else 0)
+    for m in [um,cm,clm]:
+        for it in range(NB_OF_TS):
+            f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("cell_{}".format(m.getName())) ; f.setTime(float(it),it,0)
+            a = mc.DataArrayDouble(m.getNumberOfCells()) ; a.iota(float(10*it))
+            f.setArray(a)
+            mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+            f = mc.MEDCouplingFieldDouble(mc.ON_NODES) ; f.setMesh(m) ; f.setName("node_{}".format(m.getName())) ; f.setTime(float(it),it,0)
+            a = mc.DataArrayDouble(m.getNumberOfNodes()) ; a.iota(float(100*it))
+            f.setArray(a)
+            mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+
+def geometryOf(ds):
+    """ Returns the VTK objects holding the geometry of ds. """
+    if ds.IsA("vtkUnstructuredGrid"):
+        return [ds.GetPoints().GetData(),ds.GetCells()]
+    if ds.IsA("vtkRectilinearGrid"):
+        return [ds.GetXCoordinates(),ds.GetYCoordinates(),ds.GetZCoordinates()]
+    return [ds.GetPoints().GetData()]
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader42.med"
+    generateCase(fname)
+    reader = MEDReader(FileName=fname)
+    for meshName,dsType in [("umesh","vtkUnstructuredGrid"),("cmesh","vtkRectilinearGrid"),("clmesh","vtkStructuredGrid")]:
+        cellArr = "TS0/{}/ComSup0/cell_{}@@][@@P0".format(meshName,meshName)
+        nodeArr = "TS0/{}/ComSup0/node_{}@@][@@P1".format(meshName,meshName)
+        reader.AllArrays = [cellArr,nodeArr]
+        geometries = [] ; meshMTimes = []
+        for it in range(NB_OF_TS):
+            reader.UpdatePipeline(float(it))
+            ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+            MyAssert(ds.IsA(dsType))
+            geometries.append(geometryOf(ds))# references kept so that the addresses compared below are not reused
+            meshMTimes.append(ds.GetMeshMTime())
+            cell = numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("cell_{}".format(meshName)))
+            node = numpy_support.vtk_to_numpy(ds.GetPointData().GetArray("node_{}".format(meshName)))
+            MyAssert(cell[0]==float(10*it) and cell[-1]==float(10*it+15))
+            MyAssert(node[0]==float(100*it) and node[-1]==float(100*it+24))
+        MyAssert(len(set(meshMTimes))==1)
+        for geom in geometries[1:]:
+            MyAssert([elt.GetAddressAsString("vtkObject") for elt in geom]==[elt.GetAddressAsString("vtkObject") for elt in geometries[0]])
+        # arrays deselected are not kept by the shared support
+        reader.AllArrays = [nodeArr]
+        reader.UpdatePipeline(0.)
+        ds = reader.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+        MyAssert(ds.GetCellData().GetArray("cell_{}".format(meshName)) is None)
+        MyAssert(ds.GetPointData().GetArray("node_{}".format(meshName)) is not None)
+        MyAssert([elt.GetAddressAsString("vtkObject") for elt in geometryOf(ds)]==[elt.GetAddressAsString("vtkObject") for elt in geometries[0]])
+    Delete(reader)
+
+if __name__ == "__main__":
+    test()
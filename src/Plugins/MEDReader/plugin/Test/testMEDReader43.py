@@ -0,0 +1,83 @@
+#  -*- coding: iso-8859-1 -*-
+# Copyright (C) 2021  CEA/DEN, EDF R&D
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2.1 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this library; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+#
+# See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+#
+
+__doc__ = """
+Test of ExtractGroup on families with large and sparse ids. The selection of the families is done by a table indexed by the family id
+when the ids to keep span at most 2**20 values, by a hash table otherwise : both must give the cells of the selected groups.
+"""
+
+from paraview.simple import *
+paraview.simple._DisableFirstRenderCameraReset()
+from vtk.util import numpy_support
+import medcoupling as mc
+from MEDReaderHelper import WriteInTmpDir
+
+MAX_DENSE_RANGE = 1<<20
+# one family per group, the cell i being in the family of FAMS[i%len(FAMS)]
+FAMS = [("A",-1),("B",-MAX_DENSE_RANGE),("C",-MAX_DENSE_RANGE-1),("D",-2000000000)]
+
+def MyAssert(clue):
+    if not clue:
+        raise RuntimeError("Assertion failed !")
+
+def generateCase(fname):
+    arr = mc.DataArrayDouble(11) ; arr.iota()
+    m = mc.MEDCouplingCMesh() ; m.setCoords(arr,arr) ; m = m.buildUnstructured() ; m.setName("mesh")
+    mm = mc.MEDFileUMesh() ; mm[0] = m
+    nbCells = m.getNumberOfCells()
+    mm.setFamilyFieldArr(0,mc.DataArrayInt([FAMS[i%len(FAMS)][1] for i in range(nbCells)]))
+    mm.setFamilyFieldArr(1,mc.DataArrayInt(m.getNumberOfNodes()*[0]))
+    mm.setFamilyId("FAMILLE_ZERO",0)
+    for grpName,famId in FAMS:
+        mm.setFamilyId("fam%s"%grpName,famId)
+        mm.setFamiliesOnGroup(grpName,["fam%s"%grpName])
+    mm.write(fname,2)
+    f = mc.MEDCouplingFieldDouble(mc.ON_CELLS) ; f.setMesh(m) ; f.setName("ids") ; f.setTime(0.,0,0)
+    a = mc.DataArrayDouble(nbCells) ; a.iota()
+    f.setArray(a)
+    mc.WriteFieldUsingAlreadyWrittenMesh(fname,f)
+    return nbCells
+
+@WriteInTmpDir
+def test():
+    fname = "testMEDReader43.med"
+    nbCells = generateCase(fname)
+    famIds = dict(FAMS)
+    reader = MEDReader(FileName=fname)
+    eg = ExtractGroup(Input=reader)
+    # (groups selected, dense table expected)
+    for grpNames,isDense in [(["D"],True),(["A","B"],True),(["A","C"],False),(["B","D"],False),(["A","B","C","D"],False)]:
+        ids = [famIds[grpName] for grpName in grpNames]
+        MyAssert((max(ids)-min(ids)+1<=MAX_DENSE_RANGE)==isDense)
+        for insideOut in [0,1]:
+            eg.AllGroups = ["GRP_%s"%grpName for grpName in grpNames]
+            eg.InsideOut = insideOut
+            eg.UpdatePipeline()
+            ds = eg.GetClientSideObject().GetOutputDataObject(0).GetBlock(0)
+            kept = [i for i in range(nbCells) if (FAMS[i%len(FAMS)][0] in grpNames)!=bool(insideOut)]
+            if not kept:
+                MyAssert(ds is None or ds.GetNumberOfCells()==0)
+                continue
+            MyAssert(ds.GetNumberOfCells()==len(kept))
+            MyAssert(numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("ids")).tolist()==[float(i) for i in kept])
+            MyAssert(set(numpy_support.vtk_to_numpy(ds.GetCellData().GetArray("FamilyIdCell")).tolist())==set([FAMS[i%len(FAMS)][1] for i in kept]))
+
+if __name__ == "__main__":
+    test()